@@ -0,0 +1,87 @@
+ /******************************************************************************
+ *
+ * Module: Critical
+ *
+ * File Name: Critical.h
+ *
+ * Description: Header file for the nestable critical sections based on the
+ *              Cortex-M4 PRIMASK and BASEPRI registers
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef CRITICAL_H_
+#define CRITICAL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+/*
+ * Critical_Enter masks every interrupt and exception with configurable priority by
+ * setting PRIMASK and returns its previous value, Critical_Exit puts that value back.
+ * Nested sections therefore only unmask when the outermost one exits:
+ *
+ *     Critical_StateType state = Critical_Enter();
+ *     ...
+ *     Critical_Exit(state);
+ *
+ * Both map to compiler intrinsics, there is no call overhead.
+ */
+#define Critical_Enter()                 ((Critical_StateType)_disable_interrupts())
+#define Critical_Exit(State)             _restore_interrupts(State)
+
+#define CRITICAL_BASEPRI_BITS_POS        5                  // BASEPRI uses the same upper 3 bits as the priority fields.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Mask state saved on entry, only valid as argument of the matching exit */
+typedef uint32 Critical_StateType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Critical_EnterPriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority - Most urgent priority level to mask (1 .. 7)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Critical_StateType - Previous BASEPRI value for Critical_ExitPriority
+ * Description: Function to mask only the IRQs and exceptions with priority
+ * level Priority or less urgent through BASEPRI_MAX. More urgent interrupts
+ * keep running with no added latency. The mask is only ever raised, so a
+ * nested section never unmasks what an outer section masked. Level 0 can
+ * not be masked by BASEPRI, use Critical_Enter for it.
+ * Implemented in Critical_Asm.asm.
+ * ********************************************************************/
+Critical_StateType Critical_EnterPriority(uint8 Priority);
+
+
+/*********************************************************************
+ * Service Name: Critical_ExitPriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): State - Value returned by the matching Critical_EnterPriority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to restore BASEPRI on exit of a priority based
+ * critical section. Implemented in Critical_Asm.asm.
+ * ********************************************************************/
+void Critical_ExitPriority(Critical_StateType State);
+
+
+#endif /* CRITICAL_H_ */
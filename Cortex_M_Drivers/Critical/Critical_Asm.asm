@@ -0,0 +1,44 @@
+;******************************************************************************
+;
+; Module: Critical
+;
+; File Name: Critical_Asm.asm
+;
+; Description: BASEPRI critical sections, written in assembly because the
+;              compiler has no intrinsic for the BASEPRI_MAX register
+;
+; Author: Bassam Ashraf
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  2
+
+        .global Critical_EnterPriority
+        .global Critical_ExitPriority
+
+;******************************************************************************
+; Critical_StateType Critical_EnterPriority(uint8 Priority)
+; r0 = Priority, returns the previous BASEPRI in r0.
+; BASEPRI_MAX is only written when the new mask is more restrictive than the
+; current one (and never with 0), so nested sections can not lower the mask.
+;******************************************************************************
+Critical_EnterPriority: .asmfunc
+        MRS     r1, BASEPRI
+        LSLS    r0, r0, #5                  ; CRITICAL_BASEPRI_BITS_POS
+        MSR     BASEPRI_MAX, r0
+        MOV     r0, r1
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; void Critical_ExitPriority(Critical_StateType State)
+; r0 = State returned by the matching Critical_EnterPriority.
+;******************************************************************************
+Critical_ExitPriority: .asmfunc
+        MSR     BASEPRI, r0
+        BX      lr
+        .endasmfunc
+
+        .end
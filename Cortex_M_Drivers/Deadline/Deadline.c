@@ -0,0 +1,109 @@
+ /******************************************************************************
+ *
+ * Module: Deadline
+ *
+ * File Name: Deadline.c
+ *
+ * Description: Source file for the non-blocking deadlines based on the
+ *              free-running SysTick monotonic time
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "Deadline.h"
+#include "SysTick/SysTick.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define DEADLINE_MICRO_SECONDS_PER_MILLI     1000UL
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Deadline_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time until the deadline expires
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Deadline_Type - Handle of the new deadline
+ * Description: Function to start a deadline relative to now. It only
+ * reads the SysTick monotonic time, so the SysTick timer must already
+ * run (SysTick_Init / SysTick_InitPeriod with any period) and its
+ * configuration is left untouched.
+ * ********************************************************************/
+Deadline_Type Deadline_Start(uint32 a_TimeInMilliSeconds)
+{
+    return Deadline_Advance(SysTick_GetMicros(), a_TimeInMilliSeconds);
+}
+
+
+/*********************************************************************
+ * Service Name: Deadline_Advance
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of an expired deadline
+ *                  a_TimeInMilliSeconds - Time from that deadline to the next one
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Deadline_Type - Handle of the next deadline
+ * Description: Function to chain periodic deadlines from the previous
+ * expiry instead of from now, so a polling loop does not drift by the
+ * time it takes to notice the expiry.
+ * ********************************************************************/
+Deadline_Type Deadline_Advance(Deadline_Type a_Deadline, uint32 a_TimeInMilliSeconds)
+{
+    return a_Deadline + ( (uint64) a_TimeInMilliSeconds * DEADLINE_MICRO_SECONDS_PER_MILLI );
+}
+
+
+/*********************************************************************
+ * Service Name: Deadline_Expired
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of the deadline
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE once the deadline has passed
+ * Description: Function to check a deadline without blocking.
+ * ********************************************************************/
+boolean Deadline_Expired(Deadline_Type a_Deadline)
+{
+    return (SysTick_GetMicros() >= a_Deadline) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************
+ * Service Name: Deadline_Remaining
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of the deadline
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Milliseconds until the deadline (rounded up), 0 once it expired
+ * Description: Function to get the time left until a deadline.
+ * ********************************************************************/
+uint32 Deadline_Remaining(Deadline_Type a_Deadline)
+{
+    uint64 now = SysTick_GetMicros();
+    uint64 milliSeconds;
+
+    if(now >= a_Deadline)
+    {
+        return 0;
+    }
+
+    milliSeconds = ( (a_Deadline - now) + DEADLINE_MICRO_SECONDS_PER_MILLI - 1 ) / DEADLINE_MICRO_SECONDS_PER_MILLI;    // Round up, never report 0 before expiry.
+
+    return (milliSeconds > 0xFFFFFFFFULL) ? 0xFFFFFFFFUL : (uint32) milliSeconds;
+}
@@ -0,0 +1,128 @@
+ /******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.h
+ *
+ * Description: Header file for the fault handlers that keep a crash record
+ *              in no-init RAM and reset the system
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef FAULT_H_
+#define FAULT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define FAULT_RECORD_MAGIC               0xFA017EC0UL       // Marks a record written by Fault_Capture.
+
+#define FAULT_CFSR_MSTKERR_MASK          0x00000010         // MemManage fault on exception entry stacking.
+#define FAULT_CFSR_STKERR_MASK           0x00001000         // Bus fault on exception entry stacking.
+
+#define FAULT_APINT_SYSRESREQ_MASK       0x00000004         // Request a system reset in APINT register.
+
+#define FAULT_SRAM_START                 0x20000000UL
+#define FAULT_SRAM_END                   0x20008000UL
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Crash record kept over the reset, register names follow the ARMv7-M manual */
+typedef struct
+{
+    uint32 Magic;                               // FAULT_RECORD_MAGIC while the record is valid.
+    uint32 R0;                                  // Exception frame stacked on entry, 0 if it could not be read.
+    uint32 R1;
+    uint32 R2;
+    uint32 R3;
+    uint32 R12;
+    uint32 LR;
+    uint32 PC;                                  // Instruction that faulted (or the next one for imprecise faults).
+    uint32 XPSR;
+    uint32 CFSR;                                // Configurable fault status (MemManage, Bus and Usage faults).
+    uint32 HFSR;                                // Hard fault status.
+    uint32 MMFAR;                               // MemManage fault address, valid if CFSR.MMARVALID.
+    uint32 BFAR;                                // Bus fault address, valid if CFSR.BFARVALID.
+    uint32 ExcReturn;                           // EXC_RETURN of the fault, tells the stack and mode that faulted.
+    uint32 Vector;                              // Active vector number (3 Hard fault, 4 MemManage, 5 Bus, 6 Usage, else unexpected).
+    uint32 Reserved;                            // Always 0, fills the gap in front of Ticks so the checksum never sums padding.
+    uint64 Ticks;                               // SysTick_GetTicks64 at the fault.
+    uint32 Checksum;                            // Sum of the words above.
+}Fault_RecordType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Fault_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to call once at startup. It takes over the crash
+ * record of the previous run (if any) and enables the MemManage, Bus and
+ * Usage fault exceptions so they get their own record instead of a
+ * Hard fault.
+ * ********************************************************************/
+void Fault_Init(void);
+
+
+/*********************************************************************
+ * Service Name: Fault_GetLastRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Record - Crash record of the previous run
+ * Return value: Std_ReturnType - E_OK if the previous run ended with a fault, E_NOT_OK otherwise
+ * Description: Function to read the crash record found by Fault_Init.
+ * ********************************************************************/
+Std_ReturnType Fault_GetLastRecord(Fault_RecordType *Record);
+
+
+/*********************************************************************
+ * Service Name: Fault_Capture
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Frame - Stacked exception frame, NULL_PTR if unknown
+ *                  ExcReturn - EXC_RETURN value of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to write the crash record and reset the system.
+ * Fault_Handler (Fault_Asm.asm) calls it with the frame of the faulting
+ * stack, IntDefaultHandler calls it for unexpected interrupts.
+ * ********************************************************************/
+void Fault_Capture(const uint32 *Frame, uint32 ExcReturn);
+
+
+/*********************************************************************
+ * Service Name: Fault_Handler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hard fault, MemManage, Bus fault and Usage fault handler,
+ * implemented in Fault_Asm.asm.
+ * ********************************************************************/
+void Fault_Handler(void);
+
+
+#endif /* FAULT_H_ */
@@ -0,0 +1,35 @@
+;******************************************************************************
+;
+; Module: Fault
+;
+; File Name: Fault_Asm.asm
+;
+; Description: Fault entry, written in assembly because the faulting stack
+;              pointer is only known from EXC_RETURN in LR on exception entry
+;
+; Author: Bassam Ashraf
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  2
+
+        .global Fault_Handler
+        .global Fault_Capture
+
+;******************************************************************************
+; void Fault_Handler(void)
+; EXC_RETURN bit 2 tells if the frame was stacked on MSP or PSP.
+; Calls Fault_Capture(frame, EXC_RETURN), which resets the system.
+;******************************************************************************
+Fault_Handler: .asmfunc
+        TST     lr, #4
+        ITE     EQ
+        MRSEQ   r0, MSP
+        MRSNE   r0, PSP
+        MOV     r1, lr
+        B       Fault_Capture
+        .endasmfunc
+
+        .end
@@ -0,0 +1,577 @@
+ /******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: Kernel.c
+ *
+ * Description: Source file for the minimal preemptive priority based kernel
+ *              with PendSV context switching and SysTick time slicing
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "Kernel.h"
+#include "NVIC/NVIC.h"
+#include "SysTick/SysTick.h"
+#include "Critical/Critical.h"
+#include "tm4c123gh6pm_registers.h"
+
+#if (KERNEL_BENCHMARK == TRUE)
+#include "DWT/DWT.h"
+#endif
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+/* Priority p owns bit 31 - p of the ready bitmap, so CLZ of the bitmap is the most urgent ready thread */
+#define KERNEL_READY_BIT(Priority)       (0x80000000UL >> (Priority))
+
+#define KERNEL_BOOT_STACK_WORDS          32                 // Takes the throw-away context of main at Kernel_Start.
+#define KERNEL_MAX_SLEEP                 0x7FFFFFFFUL
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+/* Used by Kernel_PendSVHandler in Kernel_Asm.asm */
+Kernel_ThreadType * volatile g_kernelCurrent = NULL_PTR;           // Thread that owns the core (PSP).
+Kernel_ThreadType * volatile g_kernelNext    = NULL_PTR;           // Thread PendSV switches to.
+
+static Kernel_ThreadType *g_readyTail[KERNEL_PRIORITIES];           // Tail of the circular ready ring of each level, the head is Tail->Next.
+static Kernel_ThreadType *g_threads[KERNEL_MAX_THREADS];            // Every created thread, scanned for sleepers on wake ticks only.
+static uint8 g_threadsNumber = 0;
+
+static volatile uint32 g_readyBitmap = 0;
+static volatile uint32 g_kernelTicks = 0;
+static volatile uint32 g_nextWake    = 0;                           // Earliest WakeTick of all sleeping threads.
+static uint32 g_sliceTicks           = 0;                           // Ticks the running thread used of its time slice.
+static boolean g_started             = FALSE;
+
+static Kernel_ThreadType g_idleThread;
+static uint32 g_idleStack[KERNEL_IDLE_STACK_WORDS];
+
+static Kernel_ThreadType g_bootThread;
+static uint32 g_bootStack[KERNEL_BOOT_STACK_WORDS];
+
+#if (KERNEL_BENCHMARK == TRUE)
+static Kernel_ThreadType g_benchThread;
+static uint32 g_benchStack[KERNEL_MIN_STACK_WORDS];
+static volatile boolean g_benchDone;
+#endif
+
+/* Implemented in Kernel_Asm.asm */
+extern void Kernel_SetPsp(uint32 *Sp);
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Append a thread to the tail of its ready ring.
+ * ********************************************************************/
+static void Kernel_ReadyAdd(Kernel_ThreadType *Thread)
+{
+    Kernel_ThreadType *tail = g_readyTail[Thread->Priority];
+
+    if(tail == NULL_PTR)
+    {
+        Thread->Next   = Thread;
+        g_readyBitmap |= KERNEL_READY_BIT(Thread->Priority);
+    }
+    else
+    {
+        Thread->Next = tail->Next;
+        tail->Next   = Thread;
+    }
+
+    g_readyTail[Thread->Priority] = Thread;
+    Thread->State = KERNEL_THREAD_READY;
+}
+
+
+/*********************************************************************
+ * Description: Unlink a ready thread from its ring. The ring is short
+ * (threads of one priority), the walk finds the predecessor.
+ * ********************************************************************/
+static void Kernel_ReadyRemove(Kernel_ThreadType *Thread)
+{
+    Kernel_ThreadType *prev = Thread;
+
+    while(prev->Next != Thread)
+    {
+        prev = prev->Next;
+    }
+
+    if(prev == Thread)
+    {
+        g_readyTail[Thread->Priority] = NULL_PTR;
+        g_readyBitmap &= ~KERNEL_READY_BIT(Thread->Priority);
+    }
+    else
+    {
+        prev->Next = Thread->Next;
+        if(g_readyTail[Thread->Priority] == Thread)
+        {
+            g_readyTail[Thread->Priority] = prev;
+        }
+    }
+}
+
+
+/*********************************************************************
+ * Description: Pick the head of the most urgent ready ring in O(1) and
+ * pend PendSV if it is not the running thread. Runs with interrupts
+ * masked; the switch happens once they are unmasked and no other
+ * exception is active.
+ * ********************************************************************/
+static void Kernel_Schedule(void)
+{
+    Kernel_ThreadType *next = g_readyTail[_norm(g_readyBitmap)]->Next;   // The idle thread keeps the bitmap non zero.
+
+    g_kernelNext = next;
+
+    if( (g_started == TRUE) && (next != g_kernelCurrent) )
+    {
+        g_sliceTicks = 0;
+        NVIC_SYSTEM_INTCTRL = NVIC_INTCTRL_PEND_SV_MASK;
+    }
+}
+
+
+/*********************************************************************
+ * Description: Make the sleepers due now ready and find the next tick
+ * with a wakeup. Runs with interrupts masked, only on wake ticks.
+ * ********************************************************************/
+static void Kernel_Wake(uint32 Now)
+{
+    uint32 nearest = KERNEL_MAX_SLEEP;
+    Kernel_ThreadType *thread;
+    uint8 index;
+
+    for(index = 0; index < g_threadsNumber; index++)
+    {
+        thread = g_threads[index];
+
+        if(thread->State == KERNEL_THREAD_SLEEPING)
+        {
+            if(thread->WakeTick == Now)
+            {
+                Kernel_ReadyAdd(thread);
+            }
+            else if( (thread->WakeTick - Now) < nearest )
+            {
+                nearest = thread->WakeTick - Now;
+            }
+        }
+    }
+
+    g_nextWake = Now + nearest;
+}
+
+
+/*********************************************************************
+ * Description: SysTick subscriber. Ticks without a wakeup and with a
+ * single thread on the running level cost two compares.
+ * ********************************************************************/
+static void Kernel_Tick(void)
+{
+    uint32 now = g_kernelTicks + 1;
+    Kernel_ThreadType *current = g_kernelCurrent;
+    Critical_StateType state;
+
+    g_kernelTicks = now;
+
+    if(g_started == FALSE)
+    {
+        return;
+    }
+
+    if( (now == g_nextWake) ||
+        ( (current->Next != current) && (current->State == KERNEL_THREAD_READY) && (++g_sliceTicks >= KERNEL_TIME_SLICE_TICKS) ) )
+    {
+        state = Critical_Enter();                   // Higher priority ISRs may create threads meanwhile.
+
+        if(now == g_nextWake)
+        {
+            Kernel_Wake(now);
+        }
+
+        if( (g_sliceTicks >= KERNEL_TIME_SLICE_TICKS) && (current->State == KERNEL_THREAD_READY) )
+        {
+            g_readyTail[current->Priority] = current;      // Round robin: the running thread becomes the tail.
+        }
+
+        Kernel_Schedule();
+
+        Critical_Exit(state);
+    }
+}
+
+
+/*********************************************************************
+ * Description: Return address of every thread function, a thread that
+ * returns leaves the ready rings for good.
+ * ********************************************************************/
+static void Kernel_ThreadExit(void)
+{
+    Critical_StateType state = Critical_Enter();
+
+    Kernel_ReadyRemove(g_kernelCurrent);
+    g_kernelCurrent->State = KERNEL_THREAD_TERMINATED;
+    Kernel_Schedule();
+
+    Critical_Exit(state);                           // PendSV switches away here.
+
+    while(1);
+}
+
+
+/*********************************************************************
+ * Description: Idle thread, sleeps the core until the next interrupt.
+ * ********************************************************************/
+static void Kernel_IdleThread(void *Arg)
+{
+    (void)Arg;
+
+    while(1)
+    {
+        SysTick_Idle();                             // Accounted as idle time for the CPU load.
+    }
+}
+
+
+/*********************************************************************
+ * Description: Build the frame Kernel_PendSVHandler restores: r4-r11
+ * and EXC_RETURN under the exception frame the core pops to start the
+ * thread function with Arg in r0.
+ * ********************************************************************/
+static void Kernel_InitFrame(Kernel_ThreadType *Thread, void (*Entry)(void *Arg), void *Arg, uint32 *Stack, uint32 StackWords)
+{
+    uint32 *sp = (uint32 *)( (uint32)(Stack + StackWords) & ~0x7UL );     // AAPCS 8 bytes stack alignment.
+    uint8 index;
+
+    *(--sp) = KERNEL_INITIAL_XPSR;
+    *(--sp) = (uint32)Entry & ~0x1UL;                                       // PC, the Thumb bit lives in xPSR.
+    *(--sp) = (uint32)Kernel_ThreadExit;                                    // LR
+    *(--sp) = 0;                                                            // R12
+    *(--sp) = 0;                                                            // R3
+    *(--sp) = 0;                                                            // R2
+    *(--sp) = 0;                                                            // R1
+    *(--sp) = (uint32)Arg;                                                  // R0
+    *(--sp) = KERNEL_EXC_RETURN_THREAD_PSP;                                 // LR of PendSV
+
+    for(index = 0; index < 8; index++)
+    {
+        *(--sp) = 0;                                                        // R11 .. R4
+    }
+
+    Thread->Sp = sp;
+}
+
+
+/*********************************************************************
+ * Description: Register a thread, in the slot of a terminated thread if
+ * there is one, and make it ready.
+ * ********************************************************************/
+static Std_ReturnType Kernel_AddThread(Kernel_ThreadType *Thread, void (*Entry)(void *Arg), void *Arg,
+                                       uint32 *Stack, uint32 StackWords, uint8 Priority)
+{
+    Critical_StateType state = Critical_Enter();
+    uint8 index;
+
+    for(index = 0; index < g_threadsNumber; index++)
+    {
+        if(g_threads[index]->State == KERNEL_THREAD_TERMINATED)
+        {
+            break;
+        }
+    }
+
+    if(index == g_threadsNumber)
+    {
+        if(g_threadsNumber >= KERNEL_MAX_THREADS)
+        {
+            Critical_Exit(state);
+            return E_NOT_OK;
+        }
+        g_threadsNumber++;
+    }
+
+    Kernel_InitFrame(Thread, Entry, Arg, Stack, StackWords);
+    Thread->Priority = Priority;
+    Thread->WakeTick = 0;
+    g_threads[index] = Thread;
+
+    Kernel_ReadyAdd(Thread);
+    Kernel_Schedule();
+
+    Critical_Exit(state);
+
+    return E_OK;
+}
+
+
+#if (KERNEL_BENCHMARK == TRUE)
+/*********************************************************************
+ * Description: Benchmark peer, yields back until the measurement ends.
+ * ********************************************************************/
+static void Kernel_BenchmarkThread(void *Arg)
+{
+    (void)Arg;
+
+    while(g_benchDone == FALSE)
+    {
+        Kernel_Yield();
+    }
+}
+#endif
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Kernel_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the SysTick subscriber table is full
+ *               or NVIC_PENDSV_OWNER does not select NVIC_PENDSV_KERNEL
+ * Description: Function to reset the kernel, create the idle thread and
+ * subscribe the kernel tick to every SysTick tick.
+ * ********************************************************************/
+Std_ReturnType Kernel_Init(void)
+{
+#if (NVIC_PENDSV_OWNER != NVIC_PENDSV_KERNEL)
+    return E_NOT_OK;                                // PendSV_Handler of the WorkQueue is installed, no switch would run.
+#else
+    Critical_StateType state;
+    uint8 priority;
+
+    state = Critical_Enter();
+
+    for(priority = 0; priority < KERNEL_PRIORITIES; priority++)
+    {
+        g_readyTail[priority] = NULL_PTR;
+    }
+
+    g_readyBitmap   = 0;
+    g_threadsNumber = 0;
+    g_sliceTicks    = 0;
+    g_started       = FALSE;
+    g_nextWake      = g_kernelTicks + KERNEL_MAX_SLEEP;
+
+    (void)Kernel_AddThread(&g_idleThread, Kernel_IdleThread, NULL_PTR, g_idleStack, KERNEL_IDLE_STACK_WORDS, KERNEL_IDLE_PRIORITY);
+
+    Critical_Exit(state);
+
+    (void)SysTick_Unsubscribe(Kernel_Tick);         // Init may run again, keep a single subscription.
+    return SysTick_Subscribe(Kernel_Tick, 1, 0);
+#endif
+}
+
+
+/*********************************************************************
+ * Service Name: Kernel_CreateThread
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Entry - Thread function, returning from it terminates the thread
+ *                  Arg - Argument passed to the thread function
+ *                  Stack - Caller owned stack memory
+ *                  StackWords - Stack size in words (at least KERNEL_MIN_STACK_WORDS)
+ *                  Priority - Thread priority (0 .. KERNEL_IDLE_PRIORITY - 1)
+ * Parameters (inout): Thread - Caller owned thread control block
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the thread table is full or an argument is invalid
+ * Description: Function to create a ready thread, before or after
+ * Kernel_Start. It preempts the caller if it is more urgent.
+ * ********************************************************************/
+Std_ReturnType Kernel_CreateThread(Kernel_ThreadType *Thread, void (*Entry)(void *Arg), void *Arg,
+                                   uint32 *Stack, uint32 StackWords, uint8 Priority)
+{
+    if( (Thread == NULL_PTR) || (Entry == NULL_PTR) || (Stack == NULL_PTR) ||
+        (StackWords < KERNEL_MIN_STACK_WORDS) || (Priority >= KERNEL_IDLE_PRIORITY) )
+    {
+        return E_NOT_OK;
+    }
+
+    return Kernel_AddThread(Thread, Entry, Arg, Stack, StackWords, Priority);
+}
+
+
+/*********************************************************************
+ * Service Name: Kernel_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to give PendSV the lowest priority and switch
+ * to the most urgent thread. The interrupt mask is restored as the caller
+ * had it and the switch runs once it allows PendSV, so call it with the
+ * interrupts enabled. NVIC_PENDSV_OWNER must select NVIC_PENDSV_KERNEL so
+ * the startup file installs Kernel_PendSVHandler.
+ * ********************************************************************/
+void Kernel_Start(void)
+{
+    Critical_StateType state = Critical_Enter();
+
+    /* Below every ISR, so a switch never delays an interrupt and always tail-chains after the last one */
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, EXCEPTION_PRIORITY_LEVEL_7);
+
+    /* The first PendSV saves the context of main into the boot stack and never restores it */
+    Kernel_SetPsp(&g_bootStack[KERNEL_BOOT_STACK_WORDS]);
+    g_bootThread.Priority = KERNEL_IDLE_PRIORITY;
+    g_bootThread.State    = KERNEL_THREAD_TERMINATED;
+    g_bootThread.Next     = &g_bootThread;
+    g_kernelCurrent       = &g_bootThread;
+
+    g_started = TRUE;
+    Kernel_Schedule();
+
+    Critical_Exit(state);                           // The pended switch runs as soon as the caller's mask allows it.
+
+    while(1);
+}
+
+
+/*********************************************************************
+ * Service Name: Kernel_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Ticks - SysTick ticks to sleep, 0 only yields
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to block the calling thread for a number of ticks.
+ * ********************************************************************/
+void Kernel_Sleep(uint32 Ticks)
+{
+    Critical_StateType state;
+    Kernel_ThreadType *current;
+
+    if(Ticks == 0)
+    {
+        Kernel_Yield();
+        return;
+    }
+
+    if(Ticks > KERNEL_MAX_SLEEP)
+    {
+        Ticks = KERNEL_MAX_SLEEP;
+    }
+
+    state   = Critical_Enter();
+    current = g_kernelCurrent;
+
+    Kernel_ReadyRemove(current);
+    current->State    = KERNEL_THREAD_SLEEPING;
+    current->WakeTick = g_kernelTicks + Ticks;
+
+    if( Ticks < (g_nextWake - g_kernelTicks) )
+    {
+        g_nextWake = current->WakeTick;
+    }
+
+    Kernel_Schedule();
+
+    Critical_Exit(state);                           // PendSV switches away here.
+}
+
+
+/*********************************************************************
+ * Service Name: Kernel_Yield
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to give the core to the next ready thread of the
+ * same priority, if there is one.
+ * ********************************************************************/
+void Kernel_Yield(void)
+{
+    Critical_StateType state = Critical_Enter();
+    Kernel_ThreadType *current = g_kernelCurrent;
+
+    g_readyTail[current->Priority] = current;       // The running thread is ready, its level has a ring.
+    Kernel_Schedule();
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Service Name: Kernel_GetCurrent
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Kernel_ThreadType* - Running thread
+ * Description: Function to get the thread control block of the caller.
+ * ********************************************************************/
+Kernel_ThreadType *Kernel_GetCurrent(void)
+{
+    return g_kernelCurrent;
+}
+
+
+#if (KERNEL_BENCHMARK == TRUE)
+/*********************************************************************
+ * Service Name: Kernel_BenchmarkSwitch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Average core cycles from one thread's Kernel_Yield call to the other thread running
+ * Description: Function to measure the context switch from a running
+ * thread: it ping-pongs KERNEL_BENCHMARK_ROUNDS times with a helper
+ * thread of the same priority, timed with the DWT cycle counter.
+ * Returns 0 if the core has no cycle counter.
+ * ********************************************************************/
+uint32 Kernel_BenchmarkSwitch(void)
+{
+    uint32 start;
+    uint32 cycles;
+    uint32 round;
+
+    if(DWT_Init() == E_NOT_OK)
+    {
+        return 0;                                   // No cycle counter to time the switches with.
+    }
+
+    g_benchDone = FALSE;
+    if(Kernel_CreateThread(&g_benchThread, Kernel_BenchmarkThread, NULL_PTR, g_benchStack,
+                           KERNEL_MIN_STACK_WORDS, g_kernelCurrent->Priority) == E_NOT_OK)
+    {
+        return 0;
+    }
+
+    Kernel_Yield();                                 // Let the peer reach its yield loop first.
+
+    start = DWT_GetCycles();
+    for(round = 0; round < KERNEL_BENCHMARK_ROUNDS; round++)
+    {
+        Kernel_Yield();                             // Two switches: to the peer and back.
+    }
+    cycles = DWT_GetCycles() - start;
+
+    g_benchDone = TRUE;
+    Kernel_Yield();                                 // The peer returns and terminates.
+
+    return cycles / (2 * KERNEL_BENCHMARK_ROUNDS);
+}
+#endif
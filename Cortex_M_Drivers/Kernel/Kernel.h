@@ -0,0 +1,190 @@
+ /******************************************************************************
+ *
+ * Module: Kernel
+ *
+ * File Name: Kernel.h
+ *
+ * Description: Header file for the minimal preemptive priority based kernel
+ *              with PendSV context switching and SysTick time slicing
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef KERNEL_H_
+#define KERNEL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define KERNEL_PRIORITIES                32                 // One ready bit per priority level, 0 is the most urgent.
+#define KERNEL_IDLE_PRIORITY             (KERNEL_PRIORITIES - 1)   // Reserved for the idle thread.
+#define KERNEL_MAX_THREADS               16                 // Threads including the idle thread.
+#define KERNEL_MIN_STACK_WORDS           64                 // Initial frame plus room for one exception with FPU state.
+#define KERNEL_IDLE_STACK_WORDS          64
+#define KERNEL_TIME_SLICE_TICKS          1                  // SysTick ticks a thread runs before an equal priority thread gets the core.
+
+#define KERNEL_BENCHMARK                 FALSE              // TRUE to build Kernel_BenchmarkSwitch, run it on the target to get the switch cost.
+#define KERNEL_BENCHMARK_ROUNDS          1000
+#define KERNEL_BENCHMARK_MAX_CYCLES      100                // Switch budget main.c checks the benchmark result against.
+
+#define KERNEL_INITIAL_XPSR              0x01000000         // Thumb state bit.
+#define KERNEL_EXC_RETURN_THREAD_PSP     0xFFFFFFFD         // Return to thread mode on PSP without FPU state.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    KERNEL_THREAD_READY,
+    KERNEL_THREAD_SLEEPING,
+    KERNEL_THREAD_TERMINATED
+}Kernel_ThreadStateType;
+
+/* Thread control block, the storage is owned by the caller and must stay valid while the thread exists */
+typedef struct Kernel_Thread_Tag
+{
+    uint32                    *Sp;              // Saved stack pointer, must stay the first member (Kernel_Asm.asm).
+    struct Kernel_Thread_Tag  *Next;            // Next thread in the ready ring of the same priority.
+    uint32                     WakeTick;        // Kernel tick that ends the sleep.
+    Kernel_ThreadStateType     State;
+    uint8                      Priority;
+}Kernel_ThreadType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Kernel_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the SysTick subscriber table is full
+ *               or NVIC_PENDSV_OWNER does not select NVIC_PENDSV_KERNEL
+ * Description: Function to reset the kernel, create the idle thread and
+ * subscribe the kernel tick to every SysTick tick.
+ * ********************************************************************/
+Std_ReturnType Kernel_Init(void);
+
+
+/*********************************************************************
+ * Service Name: Kernel_CreateThread
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Entry - Thread function, returning from it terminates the thread
+ *                  Arg - Argument passed to the thread function
+ *                  Stack - Caller owned stack memory
+ *                  StackWords - Stack size in words (at least KERNEL_MIN_STACK_WORDS)
+ *                  Priority - Thread priority (0 .. KERNEL_IDLE_PRIORITY - 1)
+ * Parameters (inout): Thread - Caller owned thread control block
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the thread table is full or an argument is invalid
+ * Description: Function to create a ready thread, before or after
+ * Kernel_Start. It preempts the caller if it is more urgent.
+ * ********************************************************************/
+Std_ReturnType Kernel_CreateThread(Kernel_ThreadType *Thread, void (*Entry)(void *Arg), void *Arg,
+                                   uint32 *Stack, uint32 StackWords, uint8 Priority);
+
+
+/*********************************************************************
+ * Service Name: Kernel_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to give PendSV the lowest priority and switch
+ * to the most urgent thread. The interrupt mask is restored as the caller
+ * had it and the switch runs once it allows PendSV, so call it with the
+ * interrupts enabled. NVIC_PENDSV_OWNER must select NVIC_PENDSV_KERNEL so
+ * the startup file installs Kernel_PendSVHandler.
+ * ********************************************************************/
+void Kernel_Start(void);
+
+
+/*********************************************************************
+ * Service Name: Kernel_Sleep
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Ticks - SysTick ticks to sleep, 0 only yields
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to block the calling thread for a number of ticks.
+ * ********************************************************************/
+void Kernel_Sleep(uint32 Ticks);
+
+
+/*********************************************************************
+ * Service Name: Kernel_Yield
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to give the core to the next ready thread of the
+ * same priority, if there is one.
+ * ********************************************************************/
+void Kernel_Yield(void);
+
+
+/*********************************************************************
+ * Service Name: Kernel_GetCurrent
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Kernel_ThreadType* - Running thread
+ * Description: Function to get the thread control block of the caller.
+ * ********************************************************************/
+Kernel_ThreadType *Kernel_GetCurrent(void);
+
+
+#if (KERNEL_BENCHMARK == TRUE)
+/*********************************************************************
+ * Service Name: Kernel_BenchmarkSwitch
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Average core cycles from one thread's Kernel_Yield call to the other thread running
+ * Description: Function to measure the context switch from a running
+ * thread: it ping-pongs KERNEL_BENCHMARK_ROUNDS times with a helper
+ * thread of the same priority, timed with the DWT cycle counter.
+ * Returns 0 if the core has no cycle counter.
+ * ********************************************************************/
+uint32 Kernel_BenchmarkSwitch(void);
+#endif
+
+
+/*********************************************************************
+ * Service Name: Kernel_PendSVHandler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: PendSV exception handler that switches the thread
+ * context, implemented in Kernel_Asm.asm.
+ * ********************************************************************/
+void Kernel_PendSVHandler(void);
+
+
+#endif /* KERNEL_H_ */
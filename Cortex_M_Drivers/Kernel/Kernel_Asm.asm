@@ -0,0 +1,68 @@
+;******************************************************************************
+;
+; Module: Kernel
+;
+; File Name: Kernel_Asm.asm
+;
+; Description: PendSV context switch and stack pointer access of the kernel,
+;              written in assembly because they work on the raw registers
+;
+; Author: Bassam Ashraf
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  2
+
+        .global Kernel_PendSVHandler
+        .global Kernel_SetPsp
+        .global g_kernelCurrent
+        .global g_kernelNext
+
+;******************************************************************************
+; void Kernel_PendSVHandler(void)
+; Saves r4-r11 and EXC_RETURN of the current thread on its stack, plus
+; s16-s31 only if EXC_RETURN bit 4 is clear (the thread used the FPU, the
+; hardware already reserved the lazy s0-s15 frame). Then switches to
+; g_kernelNext and restores it the same way.
+;******************************************************************************
+Kernel_PendSVHandler: .asmfunc
+        MRS     r0, PSP
+        TST     lr, #0x10
+        IT      EQ
+        VSTMDBEQ r0!, {s16-s31}
+        STMDB   r0!, {r4-r11, lr}
+
+        CPSID   I                           ; g_kernelNext may change in any ISR
+        LDR     r1, KernelCurrentAddr
+        LDR     r2, [r1]
+        STR     r0, [r2]                    ; g_kernelCurrent->Sp
+        LDR     r3, KernelNextAddr
+        LDR     r2, [r3]
+        STR     r2, [r1]                    ; g_kernelCurrent = g_kernelNext
+        CPSIE   I
+
+        LDR     r0, [r2]                    ; g_kernelNext->Sp
+        LDMIA   r0!, {r4-r11, lr}
+        TST     lr, #0x10
+        IT      EQ
+        VLDMIAEQ r0!, {s16-s31}
+        MSR     PSP, r0
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; void Kernel_SetPsp(uint32 *Sp)
+; r0 = new process stack pointer.
+;******************************************************************************
+Kernel_SetPsp: .asmfunc
+        MSR     PSP, r0
+        BX      lr
+        .endasmfunc
+
+        .align  4
+KernelCurrentAddr:  .word   g_kernelCurrent
+KernelNextAddr:     .word   g_kernelNext
+
+        .end
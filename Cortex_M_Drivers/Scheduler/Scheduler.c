@@ -0,0 +1,258 @@
+ /******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.c
+ *
+ * Description: Source file for the cooperative run-to-completion task
+ *              scheduler on the SysTick timebase
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "Scheduler.h"
+#include "SysTick/SysTick.h"
+#include "Critical/Critical.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+/* Priority p owns bit 31 - p of the ready bitmap, so CLZ of the bitmap is the most urgent ready task */
+#define SCHEDULER_READY_BIT(Priority)    (0x80000000UL >> (Priority))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    void (*Task)(void);                         // NULL_PTR while the priority level is free.
+    uint32 Period;                              // Ticks between releases, 0 for an event-triggered task.
+    uint32 Due;                                 // Scheduler tick of the next periodic release.
+}Scheduler_TaskType;
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+static Scheduler_TaskType g_tasks[SCHEDULER_MAX_TASKS];
+
+static volatile uint32 g_ready   = 0;               // Ready bitmap, written from ISRs and the main loop.
+static volatile uint32 g_ticks   = 0;               // Scheduler time in ticks.
+static volatile uint32 g_nextDue = 0;               // Earliest Due of all periodic tasks.
+static uint32 g_periodicMask     = 0;               // Ready bits of the periodic tasks.
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Release the periodic tasks due now, move them to their
+ * next release and find the next tick with work. Runs with interrupts
+ * masked, only on ticks with a release.
+ * ********************************************************************/
+static void Scheduler_Release(uint32 Now)
+{
+    uint32 pending = g_periodicMask;
+    uint32 nearest = SCHEDULER_MAX_PERIOD;
+    Scheduler_TaskType *task;
+    uint8 priority;
+
+    while(pending != 0)
+    {
+        priority = _norm(pending);
+        pending &= ~SCHEDULER_READY_BIT(priority);
+        task = &g_tasks[priority];
+
+        if(task->Due == Now)
+        {
+            g_ready  |= SCHEDULER_READY_BIT(priority);
+            task->Due = Now + task->Period;
+        }
+
+        if( (task->Due - Now) < nearest )
+        {
+            nearest = task->Due - Now;
+        }
+    }
+
+    g_nextDue = Now + nearest;
+}
+
+
+/*********************************************************************
+ * Description: SysTick subscriber, the only scheduler work in the
+ * interrupt. Ticks without a periodic release cost one compare.
+ * ********************************************************************/
+static void Scheduler_Tick(void)
+{
+    uint32 now = g_ticks + 1;
+    Critical_StateType state;
+
+    g_ticks = now;
+
+    if(now == g_nextDue)
+    {
+        state = Critical_Enter();                   // Higher priority ISRs may activate tasks meanwhile.
+        Scheduler_Release(now);
+        Critical_Exit(state);
+    }
+}
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the SysTick subscriber table is full
+ * Description: Function to remove all tasks and subscribe the scheduler
+ * tick to every SysTick tick. SysTick_Init sets the tick period.
+ * ********************************************************************/
+Std_ReturnType Scheduler_Init(void)
+{
+    Critical_StateType state = Critical_Enter();
+    uint8 priority;
+
+    for(priority = 0; priority < SCHEDULER_MAX_TASKS; priority++)
+    {
+        g_tasks[priority].Task = NULL_PTR;
+    }
+
+    g_ready        = 0;
+    g_periodicMask = 0;
+    g_nextDue      = g_ticks + SCHEDULER_MAX_PERIOD;
+
+    Critical_Exit(state);
+
+    (void)SysTick_Unsubscribe(Scheduler_Tick);      // Init may run again, keep a single subscription.
+
+    return SysTick_Subscribe(Scheduler_Tick, 1, 0);
+}
+
+
+/*********************************************************************
+ * Service Name: Scheduler_AddTask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Priority - Priority of the task (0 .. SCHEDULER_MAX_TASKS - 1), unique per task
+ *                  Task - Function run to completion in the main loop
+ *                  Period - Ticks between releases, 0 for an event-triggered task
+ *                  Offset - Ticks until the first periodic release, 0 to release the task now
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the priority is used or an argument is invalid
+ * Description: Function to register a periodic or event-triggered task.
+ * Periodic tasks with the same period and different offsets are never
+ * released in the same tick, which spreads their load.
+ * ********************************************************************/
+Std_ReturnType Scheduler_AddTask(Scheduler_PriorityType Priority, void (*Task)(void), uint32 Period, uint32 Offset)
+{
+    Critical_StateType state;
+    uint32 now;
+
+    if( (Priority >= SCHEDULER_MAX_TASKS) || (Task == NULL_PTR) || (Period > SCHEDULER_MAX_PERIOD) || (Offset > SCHEDULER_MAX_PERIOD) ||
+        (g_tasks[Priority].Task != NULL_PTR) )
+    {
+        return E_NOT_OK;
+    }
+
+    state = Critical_Enter();
+    now   = g_ticks;
+
+    g_tasks[Priority].Task   = Task;
+    g_tasks[Priority].Period = Period;
+
+    if(Offset == 0)
+    {
+        g_ready |= SCHEDULER_READY_BIT(Priority);
+    }
+
+    if(Period != 0)
+    {
+        g_tasks[Priority].Due = now + ( (Offset == 0) ? Period : Offset );
+        g_periodicMask |= SCHEDULER_READY_BIT(Priority);
+
+        if( (g_tasks[Priority].Due - now) < (g_nextDue - now) )
+        {
+            g_nextDue = g_tasks[Priority].Due;
+        }
+    }
+
+    Critical_Exit(state);
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Activate
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority - Priority of a registered task
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to release a task from an ISR or another task.
+ * A task released again before it ran still runs once.
+ * ********************************************************************/
+void Scheduler_Activate(Scheduler_PriorityType Priority)
+{
+    Critical_StateType state;
+
+    if( (Priority < SCHEDULER_MAX_TASKS) && (g_tasks[Priority].Task != NULL_PTR) )
+    {
+        state = Critical_Enter();
+        g_ready |= SCHEDULER_READY_BIT(Priority);
+        Critical_Exit(state);
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Run
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to run as the main loop. It runs the most urgent
+ * ready task to completion, then looks again, and sleeps with WFI while
+ * no task is ready.
+ * ********************************************************************/
+void Scheduler_Run(void)
+{
+    Critical_StateType state;
+    uint8 priority;
+
+    while(1)
+    {
+        state = Critical_Enter();
+
+        if(g_ready == 0)
+        {
+            SysTick_Idle();                             // WFI wakes on a pending interrupt even with PRIMASK set, no release is missed.
+            Critical_Exit(state);                       // Run the handler that woke the core.
+            continue;
+        }
+
+        priority = _norm(g_ready);
+        g_ready &= ~SCHEDULER_READY_BIT(priority);
+        Critical_Exit(state);
+
+        g_tasks[priority].Task();
+    }
+}
@@ -0,0 +1,377 @@
+ /******************************************************************************
+ *
+ * Module: SwTimer
+ *
+ * File Name: SwTimer.c
+ *
+ * Description: Source file for the software timers multiplexed on the SysTick
+ *              interrupt using a two level hierarchical timer wheel
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "SwTimer.h"
+#include "Critical/Critical.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+/* Slot s owns bit 31 - (s % 32) of word s / 32 of the occupancy bitmap, so CLZ finds the next occupied slot */
+#define SWTIMER_SLOT_WORD(Slot)          ((Slot) >> 5)
+#define SWTIMER_SLOT_BIT(Slot)           (0x80000000UL >> ((Slot) & 0x1F))
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+static SwTimer_Type *g_level0Wheel[SWTIMER_LEVEL0_SLOTS];          // Timers expiring within the next 256 ticks, one slot per tick.
+static SwTimer_Type *g_level1Wheel[SWTIMER_LEVEL1_SLOTS];          // Later timers, one slot per block of 256 ticks.
+
+static uint32 g_level0Occupied[SWTIMER_LEVEL0_SLOTS / 32];          // Non empty level 0 slots.
+static uint32 g_level1Occupied[SWTIMER_LEVEL1_SLOTS / 32];          // Non empty level 1 slots.
+
+static SwTimer_Type *g_cascadeList = NULL_PTR;                      // Level 1 block SwTimer_Tick is moving down to level 0.
+
+static volatile uint32 g_wheelTicks = 0;                            // Current wheel time in ticks.
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Link a timer into the wheel slot that matches its
+ * expiry. Timers beyond the level 1 horizon are parked in the slot of
+ * the current block, which is visited again after a full turn and
+ * re-hashes them.
+ * ********************************************************************/
+static void SwTimer_Insert(SwTimer_Type *Timer)
+{
+    uint32 delta = Timer->Expiry - g_wheelTicks;
+    SwTimer_Type **slot;
+    uint32 index;
+
+    if(delta < SWTIMER_LEVEL0_SLOTS)
+    {
+        index = Timer->Expiry & SWTIMER_LEVEL0_MASK;
+        slot  = &g_level0Wheel[index];
+        g_level0Occupied[SWTIMER_SLOT_WORD(index)] |= SWTIMER_SLOT_BIT(index);
+    }
+    else
+    {
+        if(delta < (SWTIMER_LEVEL0_SLOTS * SWTIMER_LEVEL1_SLOTS))
+        {
+            index = (Timer->Expiry >> SWTIMER_LEVEL0_BITS) & SWTIMER_LEVEL1_MASK;
+        }
+        else
+        {
+            index = (g_wheelTicks >> SWTIMER_LEVEL0_BITS) & SWTIMER_LEVEL1_MASK;
+        }
+        slot = &g_level1Wheel[index];
+        g_level1Occupied[SWTIMER_SLOT_WORD(index)] |= SWTIMER_SLOT_BIT(index);
+    }
+
+    Timer->Next     = *slot;
+    Timer->PrevNext = slot;
+    if(*slot != NULL_PTR)
+    {
+        (*slot)->PrevNext = &Timer->Next;
+    }
+    *slot = Timer;
+}
+
+
+/*********************************************************************
+ * Description: Unlink an armed timer from its wheel slot. A timer that
+ * was the only one of its slot links to the slot itself, which then
+ * leaves the occupancy bitmap.
+ * ********************************************************************/
+static void SwTimer_Remove(SwTimer_Type *Timer)
+{
+    SwTimer_Type **link = Timer->PrevNext;
+    uint32 index;
+
+    *link = Timer->Next;
+    if(Timer->Next != NULL_PTR)
+    {
+        Timer->Next->PrevNext = link;
+    }
+    else if( (link >= &g_level0Wheel[0]) && (link < &g_level0Wheel[SWTIMER_LEVEL0_SLOTS]) )
+    {
+        index = (uint32) (link - &g_level0Wheel[0]);
+        g_level0Occupied[SWTIMER_SLOT_WORD(index)] &= ~SWTIMER_SLOT_BIT(index);
+    }
+    else if( (link >= &g_level1Wheel[0]) && (link < &g_level1Wheel[SWTIMER_LEVEL1_SLOTS]) )
+    {
+        index = (uint32) (link - &g_level1Wheel[0]);
+        g_level1Occupied[SWTIMER_SLOT_WORD(index)] &= ~SWTIMER_SLOT_BIT(index);
+    }
+    Timer->PrevNext = NULL_PTR;
+}
+
+
+/*********************************************************************
+ * Description: Find the first occupied slot of a wheel in the a_Count
+ * slots from a_Start on (wrapping), one CLZ per bitmap word. Returns
+ * the offset from a_Start, a_Count if the slots are all empty.
+ * ********************************************************************/
+static uint32 SwTimer_FindOccupied(const uint32 *a_Occupied, uint32 a_SlotsMask, uint32 a_Start, uint32 a_Count)
+{
+    uint32 offset = 0;
+    uint32 slot;
+    uint32 word;
+
+    while(offset < a_Count)
+    {
+        slot = (a_Start + offset) & a_SlotsMask;
+        word = a_Occupied[SWTIMER_SLOT_WORD(slot)] << (slot & 0x1F);      // Slots from this one to the end of the word.
+
+        if(word != 0)
+        {
+            offset += _norm(word);
+            return (offset < a_Count) ? offset : a_Count;
+        }
+
+        offset += 32 - (slot & 0x1F);
+    }
+
+    return a_Count;
+}
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): CallBack - Function to call on every expiry
+ *                  Arg - Argument passed to the call-back function
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to initialize a stopped software timer.
+ * ********************************************************************/
+void SwTimer_Init(SwTimer_Type *Timer, void (*CallBack)(void *Arg), void *Arg)
+{
+    Timer->Next     = NULL_PTR;
+    Timer->PrevNext = NULL_PTR;
+    Timer->Expiry   = 0;
+    Timer->Timeout  = 0;
+    Timer->Period   = 0;
+    Timer->CallBack = CallBack;
+    Timer->Arg      = Arg;
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): Timeout - Ticks until the first expiry (1 .. SWTIMER_MAX_TIMEOUT)
+ *                  Period - Ticks between later expiries, 0 for a one-shot timer
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the timer is armed, E_NOT_OK for an invalid request
+ * Description: Function to arm a software timer in O(1). A running timer
+ * is re-armed with the new timeout.
+ * ********************************************************************/
+Std_ReturnType SwTimer_Start(SwTimer_Type *Timer, uint32 Timeout, uint32 Period)
+{
+    Critical_StateType state;
+
+    if( (Timer->CallBack == NULL_PTR) || (Timeout == 0) || (Timeout > SWTIMER_MAX_TIMEOUT) || (Period > SWTIMER_MAX_TIMEOUT) )
+    {
+        return E_NOT_OK;
+    }
+
+    state = Critical_Enter();                       // The wheel is shared with SwTimer_Tick in the SysTick handler.
+
+    if(Timer->PrevNext != NULL_PTR)
+    {
+        SwTimer_Remove(Timer);
+    }
+
+    Timer->Timeout = Timeout;
+    Timer->Period  = Period;
+    Timer->Expiry  = g_wheelTicks + Timeout;
+    SwTimer_Insert(Timer);
+
+    Critical_Exit(state);
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Restart
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): None
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the timer is armed, E_NOT_OK if it was never started
+ * Description: Function to re-arm a software timer in O(1) with the
+ * timeout and period of its last start (e.g. to kick a watchdog timeout).
+ * ********************************************************************/
+Std_ReturnType SwTimer_Restart(SwTimer_Type *Timer)
+{
+    return SwTimer_Start(Timer, Timer->Timeout, Timer->Period);
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): None
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to stop a software timer in O(1).
+ * ********************************************************************/
+void SwTimer_Stop(SwTimer_Type *Timer)
+{
+    Critical_StateType state = Critical_Enter();
+
+    if(Timer->PrevNext != NULL_PTR)
+    {
+        SwTimer_Remove(Timer);
+    }
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_IsRunning
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Timer - Caller owned timer object
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the timer is armed
+ * Description: Function to check if a software timer is armed.
+ * ********************************************************************/
+boolean SwTimer_IsRunning(const SwTimer_Type *Timer)
+{
+    return (Timer->PrevNext != NULL_PTR) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the timer wheel by one tick and run
+ * the call-backs of the expired timers. It only touches the current wheel
+ * slot, so it is installed as the SysTick call-back:
+ * SysTick_SetCallBack(SwTimer_Tick). Every 256 ticks it also moves the
+ * timers of the level 1 block that starts down to level 0: that tick costs
+ * O(timers in the block), but interrupts are only masked for one timer
+ * at a time.
+ * ********************************************************************/
+void SwTimer_Tick(void)
+{
+    Critical_StateType state = Critical_Enter();    // Higher priority ISRs may start or stop timers meanwhile.
+    uint32 now   = g_wheelTicks + 1;
+    uint32 block = (now >> SWTIMER_LEVEL0_BITS) & SWTIMER_LEVEL1_MASK;
+    SwTimer_Type *timer;
+    void (*callBack)(void *Arg);
+    void *arg;
+
+    g_wheelTicks = now;
+
+    if( (now & SWTIMER_LEVEL0_MASK) == 0 )
+    {
+        /* Start of a new 256 ticks block: take the timers of this block off level 1 at once */
+        g_cascadeList = g_level1Wheel[block];
+        g_level1Wheel[block] = NULL_PTR;
+        g_level1Occupied[SWTIMER_SLOT_WORD(block)] &= ~SWTIMER_SLOT_BIT(block);
+        if(g_cascadeList != NULL_PTR)
+        {
+            g_cascadeList->PrevNext = &g_cascadeList;   // Still linked, so they can be stopped or restarted meanwhile.
+        }
+
+        /* And move them down to level 0 one per masked section, the cascade never delays an interrupt by more than one move */
+        while( (timer = g_cascadeList) != NULL_PTR )
+        {
+            SwTimer_Remove(timer);
+            SwTimer_Insert(timer);
+
+            Critical_Exit(state);
+            state = Critical_Enter();
+        }
+    }
+
+    /* Every timer left in the current level 0 slot expires exactly now */
+    while( (timer = g_level0Wheel[now & SWTIMER_LEVEL0_MASK]) != NULL_PTR )
+    {
+        SwTimer_Remove(timer);
+
+        if(timer->Period != 0)
+        {
+            timer->Expiry += timer->Period;         // Keep the period phase locked to the first expiry.
+            SwTimer_Insert(timer);
+        }
+
+        callBack = timer->CallBack;
+        arg      = timer->Arg;
+
+        Critical_Exit(state);
+        callBack(arg);                              // The call-back may start or stop any timer, including this one.
+        state = Critical_Enter();
+    }
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Service Name: SwTimer_GetTicksToNextExpiry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the wheel has work to do, SWTIMER_MAX_TIMEOUT if no timer runs
+ * Description: Function to find the next tick that expires a timer or
+ * cascades level 1 timers, used as deadline source for tickless idle:
+ * SysTick_EnterTicklessIdle(SwTimer_GetTicksToNextExpiry).
+ * ********************************************************************/
+uint32 SwTimer_GetTicksToNextExpiry(void)
+{
+    Critical_StateType state = Critical_Enter();    // A few bitmap words, not a scan of the wheels.
+    uint32 now   = g_wheelTicks;
+    uint32 ticks = SWTIMER_MAX_TIMEOUT;
+    uint32 offset;
+
+    /* Level 1 timers need the cascade tick at the start of their block */
+    offset = SwTimer_FindOccupied(g_level1Occupied, SWTIMER_LEVEL1_MASK, (now >> SWTIMER_LEVEL0_BITS) + 1, SWTIMER_LEVEL1_SLOTS);
+    if(offset < SWTIMER_LEVEL1_SLOTS)
+    {
+        ticks = (((now >> SWTIMER_LEVEL0_BITS) + 1 + offset) << SWTIMER_LEVEL0_BITS) - now;
+    }
+
+    /* Level 0 timers expire exactly at their slot */
+    offset = SwTimer_FindOccupied(g_level0Occupied, SWTIMER_LEVEL0_MASK, now + 1, SWTIMER_LEVEL0_SLOTS - 1);
+    if( (offset < (SWTIMER_LEVEL0_SLOTS - 1)) && ((offset + 1) < ticks) )
+    {
+        ticks = offset + 1;
+    }
+
+    Critical_Exit(state);
+
+    return ticks;
+}
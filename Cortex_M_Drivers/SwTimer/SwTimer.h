@@ -0,0 +1,161 @@
+ /******************************************************************************
+ *
+ * Module: SwTimer
+ *
+ * File Name: SwTimer.h
+ *
+ * Description: Header file for the software timers multiplexed on the SysTick
+ *              interrupt using a two level hierarchical timer wheel
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef SWTIMER_H_
+#define SWTIMER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define SWTIMER_LEVEL0_BITS              8                                      // Level 0 wheel resolves timeouts of up to 256 ticks to the exact tick.
+#define SWTIMER_LEVEL0_SLOTS             (1UL << SWTIMER_LEVEL0_BITS)
+#define SWTIMER_LEVEL0_MASK              (SWTIMER_LEVEL0_SLOTS - 1)
+
+#define SWTIMER_LEVEL1_BITS              6                                      // Level 1 wheel holds timeouts in blocks of 256 ticks (16384 ticks horizon).
+#define SWTIMER_LEVEL1_SLOTS             (1UL << SWTIMER_LEVEL1_BITS)
+#define SWTIMER_LEVEL1_MASK              (SWTIMER_LEVEL1_SLOTS - 1)
+
+#define SWTIMER_MAX_TIMEOUT              0x7FFFFFFFUL                           // Longer timeouts park in level 1 and are re-hashed on every cascade.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Software timer object, the storage is owned by the caller and must stay valid while the timer runs */
+typedef struct SwTimer_Tag
+{
+    struct SwTimer_Tag  *Next;                  // Next timer in the same wheel slot.
+    struct SwTimer_Tag **PrevNext;              // Link that points to this timer, NULL_PTR while the timer is stopped.
+    uint32               Expiry;                // Absolute wheel tick of the next expiry.
+    uint32               Timeout;               // Ticks from start to the first expiry.
+    uint32               Period;                // Ticks between periodic expiries, 0 for a one-shot timer.
+    void               (*CallBack)(void *Arg);  // Function executed in the SysTick handler on expiry.
+    void                *Arg;                   // Argument passed to the call-back function.
+}SwTimer_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): CallBack - Function to call on every expiry
+ *                  Arg - Argument passed to the call-back function
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to initialize a stopped software timer.
+ * ********************************************************************/
+void SwTimer_Init(SwTimer_Type *Timer, void (*CallBack)(void *Arg), void *Arg);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): Timeout - Ticks until the first expiry (1 .. SWTIMER_MAX_TIMEOUT)
+ *                  Period - Ticks between later expiries, 0 for a one-shot timer
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the timer is armed, E_NOT_OK for an invalid request
+ * Description: Function to arm a software timer in O(1). A running timer
+ * is re-armed with the new timeout.
+ * ********************************************************************/
+Std_ReturnType SwTimer_Start(SwTimer_Type *Timer, uint32 Timeout, uint32 Period);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Restart
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): None
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the timer is armed, E_NOT_OK if it was never started
+ * Description: Function to re-arm a software timer in O(1) with the
+ * timeout and period of its last start (e.g. to kick a watchdog timeout).
+ * ********************************************************************/
+Std_ReturnType SwTimer_Restart(SwTimer_Type *Timer);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different timers
+ * Parameters (in): None
+ * Parameters (inout): Timer - Caller owned timer object
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to stop a software timer in O(1).
+ * ********************************************************************/
+void SwTimer_Stop(SwTimer_Type *Timer);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_IsRunning
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Timer - Caller owned timer object
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the timer is armed
+ * Description: Function to check if a software timer is armed.
+ * ********************************************************************/
+boolean SwTimer_IsRunning(const SwTimer_Type *Timer);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_Tick
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to advance the timer wheel by one tick and run
+ * the call-backs of the expired timers. It only touches the current wheel
+ * slot, so it is installed as the SysTick call-back:
+ * SysTick_SetCallBack(SwTimer_Tick). Every 256 ticks it also moves the
+ * timers of the level 1 block that starts down to level 0: that tick costs
+ * O(timers in the block), but interrupts are only masked for one timer
+ * at a time.
+ * ********************************************************************/
+void SwTimer_Tick(void);
+
+
+/*********************************************************************
+ * Service Name: SwTimer_GetTicksToNextExpiry
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Ticks until the wheel has work to do, SWTIMER_MAX_TIMEOUT if no timer runs
+ * Description: Function to find the next tick that expires a timer or
+ * cascades level 1 timers, used as deadline source for tickless idle:
+ * SysTick_EnterTicklessIdle(SwTimer_GetTicksToNextExpiry).
+ * ********************************************************************/
+uint32 SwTimer_GetTicksToNextExpiry(void);
+
+
+#endif /* SWTIMER_H_ */
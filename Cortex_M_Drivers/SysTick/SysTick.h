@@ -25,7 +25,128 @@
 
 #define SYSTICK_CTRL_COUNT_FLAG_MASK             0x00010000         // Count flag bit mask in SysTick CTRL register.
 #define SYSTICK_CTRL_ENABLE_MASK                 0x00000001         // Enable bit mask in SysTick CTRL register.
-#define SYSTICK_RELOAD_VALUE                     16000              // Used to calculate value of reload register with given time in milliseconds.
+
+#define SYSTICK_PIOSC_HZ                         16000000UL         // Precision internal oscillator, the system clock after reset.
+#define SYSTICK_LFIOSC_HZ                        30000UL            // Low frequency internal oscillator (nominal).
+#define SYSTICK_HIB_OSC_HZ                       32768UL            // Hibernation module 32.768 kHz oscillator.
+
+#define SYSCTL_RCC_XTAL_MASK                     0x000007C0         // Crystal value field in RCC register.
+#define SYSCTL_RCC_XTAL_BITS_POS                 6
+#define SYSCTL_RCC_OSCSRC_MASK                   0x00000030         // Oscillator source field in RCC register.
+#define SYSCTL_RCC_OSCSRC_BITS_POS               4
+#define SYSCTL_RCC_BYPASS_MASK                   0x00000800         // PLL bypass bit in RCC register.
+#define SYSCTL_RCC_USESYSDIV_MASK                0x00400000         // Enable system clock divider bit in RCC register.
+#define SYSCTL_RCC_SYSDIV_MASK                   0x07800000         // System clock divisor field in RCC register.
+#define SYSCTL_RCC_SYSDIV_BITS_POS               23
+
+#define SYSCTL_RCC2_USERCC2_MASK                 0x80000000         // RCC2 overrides the RCC fields when set.
+#define SYSCTL_RCC2_DIV400_MASK                  0x40000000         // Divide the 400 MHz PLL output instead of 200 MHz.
+#define SYSCTL_RCC2_SYSDIV2_MASK                 0x1F800000         // System clock divisor field in RCC2 register.
+#define SYSCTL_RCC2_SYSDIV2_BITS_POS             23
+#define SYSCTL_RCC2_SYSDIV2_400_MASK             0x1FC00000         // SYSDIV2 with SYSDIV2LSB, used when DIV400 is set.
+#define SYSCTL_RCC2_SYSDIV2_400_BITS_POS         22
+#define SYSCTL_RCC2_BYPASS2_MASK                 0x00000800         // PLL bypass bit in RCC2 register.
+#define SYSCTL_RCC2_OSCSRC2_MASK                 0x00000070         // Oscillator source field in RCC2 register.
+#define SYSCTL_RCC2_OSCSRC2_BITS_POS             4
+
+#define SYSCTL_OSCSRC_MAIN                       0                  // Main oscillator (crystal selected by RCC XTAL).
+#define SYSCTL_OSCSRC_PIOSC                      1                  // Precision internal oscillator.
+#define SYSCTL_OSCSRC_PIOSC_DIV4                 2                  // Precision internal oscillator / 4.
+#define SYSCTL_OSCSRC_LFIOSC                     3                  // Low frequency internal oscillator.
+#define SYSCTL_OSCSRC_HIB_32KHZ                  7                  // Hibernation oscillator (RCC2 only).
+
+#define SYSCTL_PLLFREQ0_MINT_MASK                0x000003FF         // PLL M integer value.
+#define SYSCTL_PLLFREQ0_MFRAC_MASK               0x000FFC00         // PLL M fractional value (1/1024 units).
+#define SYSCTL_PLLFREQ0_MFRAC_BITS_POS           10
+#define SYSCTL_PLLFREQ1_N_MASK                   0x0000001F         // PLL N input divider.
+#define SYSCTL_PLLFREQ1_Q_MASK                   0x00001F00         // PLL Q output divider.
+#define SYSCTL_PLLFREQ1_Q_BITS_POS               8
+
+#define SYSCTL_RCGCHIB_R0_MASK                   0x00000001         // Hibernation module clock gate in RCGCHIB register.
+#define HIB_CTL_WRC_MASK                         0x80000000         // Write complete bit in HIB CTL register, poll before every HIB write.
+#define HIB_CTL_CLK32EN_MASK                     0x00000040         // 32.768 kHz hibernation oscillator enable bit in HIB CTL register.
+#define HIB_CTL_RTCEN_MASK                       0x00000001         // RTC enable bit in HIB CTL register.
+#define HIB_RTCSS_RTCSSC_MASK                    0x00007FFF         // RTC sub seconds counter field in HIB RTCSS register (1/32768 s).
+#define HIB_RTCSS_BITS                           15
+
+#define SYSTICK_INTCTRL_PENDSTSET_MASK           0x04000000         // SysTick pending bit mask in INTCTRL register (read: pending, write 1: set pending).
+#define SYSTICK_INTCTRL_PENDSTCLR_MASK           0x02000000         // SysTick clear pending bit mask in INTCTRL register (write 1: remove pending).
+#define SYSTICK_INTCTRL_VECTACTIVE_MASK          0x000001FF         // Exception number of the running handler in INTCTRL register.
+#define SYSTICK_SYSHNDCTRL_TICKACT_MASK          0x00000800         // SysTick handler active (running or preempted) bit in SYSHNDCTRL register.
+#define SYSTICK_EXCEPTION_NUMBER                 15
+
+#define SYSTICK_MAX_CYCLE_TICKS                  0x01000000         // Longest counter cycle the 24-bit reload register allows.
+#define SYSTICK_TICKLESS_MIN_IDLE_TICKS          3                  // Shorter idle times are slept with the normal tick running.
+#define SYSTICK_LATENCY_STATS                    FALSE              // TRUE to measure the handler entry latency (compiled out completely when FALSE).
+#define SYSTICK_LATENCY_BUCKETS                  25                 // Bucket 0 holds latency 0, bucket n holds latencies of 2^(n-1) .. 2^n - 1 clocks.
+#define SYSTICK_CPU_LOAD                         FALSE              // TRUE to measure the CPU load from the time slept in SysTick_Idle (compiled out completely when FALSE).
+#define SYSTICK_CPU_LOAD_HISTORY                 60                 // One second windows kept for the rolling 10 s and 60 s loads.
+#define SYSTICK_OVERRUN_CHECK                    FALSE              // TRUE to detect late/lost ticks and time the call-backs (compiled out completely when FALSE). Every tick
+                                                                            // then reads CURRENT, CYCCNT and INTCTRL, dispatch ticks read CYCCNT again and InitPeriod starts the DWT.
+#define SYSTICK_CALIBRATION_MAX_SECONDS          60                 // Longest calibration window.
+#define SYSTICK_CALIBRATION_MAX_PPM              100000UL           // Larger deviations from the nominal clock are rejected (no 32.768 kHz crystal).
+#define SYSTICK_CALIBRATION_START_SECONDS        2                  // Time the hibernation oscillator gets to start counting.
+#define SYSTICK_CALIBRATION_SETTLE_SECONDS       1                  // RTC seconds a just started crystal runs before its edges are timed.
+
+#define SYSTICK_MAX_SUBSCRIBERS                  8                  // Capacity of the subscriber table (SysTick_SetCallBack takes one entry).
+
+#define SYSTICK_MIN_PERIOD_TICKS                 160                // Shortest accepted period in core clocks (10 us at 16 MHz, 2 us at 80 MHz), leaves the core time outside the handler.
+#define SYSTICK_PRESCALER_SEARCH_SPAN            64                 // Larger prescalers tried for an exact split of a long period.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    SYSTICK_UNIT_NANO_SECONDS,
+    SYSTICK_UNIT_MICRO_SECONDS,
+    SYSTICK_UNIT_MILLI_SECONDS,
+    SYSTICK_UNIT_SECONDS
+}SysTick_TimeUnitType;
+
+
+typedef enum
+{
+    SYSTICK_PAUSE_EXCLUDE_TIME,
+    SYSTICK_PAUSE_INCLUDE_TIME
+}SysTick_PauseModeType;
+
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+typedef enum
+{
+    SYSTICK_LOAD_1S,
+    SYSTICK_LOAD_10S,
+    SYSTICK_LOAD_60S,
+    SYSTICK_LOAD_WINDOWS
+}SysTick_LoadWindowType;
+#endif
+
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+/* Tick overruns, in SysTick (core) clocks */
+typedef struct
+{
+    uint32 LateTicks;                               // Handler still running when the next tick came, that tick ran late.
+    uint32 LostTicks;                               // Ticks that came while another one was already pending (no handler ran for them).
+    uint32 WorstCallBackCycles;                     // Longest handler run on a tick with due call-backs, from handler entry.
+}SysTick_OverrunStatsType;
+#endif
+
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+/* Handler entry latency in SysTick clocks, measured from the counter reload */
+typedef struct
+{
+    uint32 Samples;                                 // Number of handler entries measured.
+    uint32 Min;                                     // Shortest latency.
+    uint32 Max;                                     // Longest latency (Max - Min is the jitter).
+    uint32 Mean;                                    // Average latency, computed on read.
+    uint64 Sum;                                     // Sum of all latencies.
+    uint32 Histogram[SYSTICK_LATENCY_BUCKETS];      // Log2 bucketed counts.
+}SysTick_LatencyStatsType;
+#endif
 
 /*******************************************************************************
  *                            Functions Prototypes                             *
@@ -43,10 +164,29 @@
  * Description: Initialize the SysTick timer with the specified time
  * in milliseconds using interrupts. This function is used to setup the
  * timer to generate periodic interrupts every specified time in milliseconds.
+ * Same as SysTick_InitPeriod(a_TimeInMilliSeconds, SYSTICK_UNIT_MILLI_SECONDS, NULL_PTR).
  * ****************************************************************************/
 void SysTick_Init(uint16 a_TimeInMilliSeconds);
 
 
+/*****************************************************************************
+ * Service Name: SysTick_InitPeriod
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Period - Period of the call-back in units of a_Unit
+ *                  a_Unit - Unit of a_Period (ns, us, ms or s)
+ * Parameters (inout): None
+ * Parameters (out): a_AchievedNanoSeconds - Period actually programmed in nanoseconds (may be NULL_PTR)
+ * Return value: Std_ReturnType - E_OK if the timer runs, E_NOT_OK if the period can not be generated
+ * Description: Initialize the SysTick timer to run the call-back every
+ * given period using interrupts. Periods longer than the 24-bit counter
+ * are split in a hardware reload value and a software prescaler that
+ * runs the call-back every prescaler counter wraps. Periods shorter than
+ * SYSTICK_MIN_PERIOD_TICKS are rejected and the timer is left unchanged.
+ * ****************************************************************************/
+Std_ReturnType SysTick_InitPeriod(uint32 a_Period, SysTick_TimeUnitType a_Unit, uint64 *a_AchievedNanoSeconds);
+
+
 /*********************************************************************
  * Service Name: SysTick_StartBusyWait
  * Sync/Async:
@@ -58,6 +198,12 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds);
  * Description: Initialize the SysTick timer with the specified time
  * in milliseconds using polling or busy-wait technique. The function
  * should exit when the time is elapsed and stops the timer at the end.
+ * Times above the 24-bit counter range wait for several counter wraps.
+ * If the timer already runs in interrupt mode the function waits on
+ * SysTick_GetTicks64 instead and keeps the configuration (see also the
+ * non-blocking Deadline module). While the timer is paused
+ * (SysTick_Pause) it waits on the DWT cycle counter and leaves the
+ * frozen configuration untouched.
  * ********************************************************************/
 void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds);
 
@@ -85,11 +231,43 @@ void SysTick_Handler(void);
  * Parameters (out): None
  * Return value: None
  * Description: Function to setup the SysTick Timer call back
- * to be executed in the SysTick Handler.
+ * to be executed in the SysTick Handler. The call-back takes a
+ * subscriber entry with divider 1 and replaces the previous one.
  * ********************************************************************/
 void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
 
 
+/*********************************************************************
+ * Service Name: SysTick_Subscribe
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_CallBack - Function to execute in the SysTick handler
+ *                  a_Divider - Run the call-back every a_Divider ticks (1 = every tick)
+ *                  a_Phase - Tick count modulo a_Divider at which the call-back runs (0 .. a_Divider - 1)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the table is full, the call-back is already subscribed or an argument is invalid
+ * Description: Function to add a call-back to the SysTick subscriber
+ * table. Subscribers with the same divider and different phases never
+ * run in the same tick, which spreads their load.
+ * ********************************************************************/
+Std_ReturnType SysTick_Subscribe(void (*a_CallBack)(void), uint32 a_Divider, uint32 a_Phase);
+
+
+/*********************************************************************
+ * Service Name: SysTick_Unsubscribe
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_CallBack - Function given to SysTick_Subscribe
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the call-back is not subscribed
+ * Description: Function to remove a call-back from the SysTick
+ * subscriber table.
+ * ********************************************************************/
+Std_ReturnType SysTick_Unsubscribe(void (*a_CallBack)(void));
+
+
 /*********************************************************************
  * Service Name: SysTick_Stop
  * Sync/Async:
@@ -116,6 +294,44 @@ void SysTick_Stop(void);
 void SysTick_Start(void);
 
 
+/*********************************************************************
+ * Service Name: SysTick_Pause
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Mode - SYSTICK_PAUSE_EXCLUDE_TIME to shift the schedule and the monotonic
+ *                           time by the pause, SYSTICK_PAUSE_INCLUDE_TIME to keep both locked to wall time
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pause the SysTick Timer. The counter is frozen
+ * and keeps the remaining count of the current period, the monotonic
+ * time holds still until SysTick_Resume. Including the paused time uses
+ * the hibernation RTC, which this function starts, so the pause may be
+ * of any length and span sleep; the DWT cycle counter refines it to the
+ * clock. Only while the RTC crystal starts (the first such pause, unless
+ * SysTick_Calibrate ran) the DWT count alone is used, which requires a
+ * pause shorter than 2^32 core clocks without sleep.
+ * ********************************************************************/
+void SysTick_Pause(SysTick_PauseModeType a_Mode);
+
+
+/*********************************************************************
+ * Service Name: SysTick_Resume
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to resume the SysTick Timer after SysTick_Pause.
+ * Excluding the paused time, the counter continues with the remaining
+ * count it was frozen at. Including it, the paused time is added to the
+ * monotonic time, the periods missed during the pause are replayed to
+ * the subscribers and the counter is restarted on the original tick grid.
+ * ********************************************************************/
+void SysTick_Resume(void);
+
+
 /*********************************************************************
  * Service Name: SysTick_DeInit
  * Sync/Async:
@@ -129,4 +345,233 @@ void SysTick_Start(void);
 void SysTick_DeInit(void);
 
 
+/*********************************************************************
+ * Service Name: SysTick_GetTicks64
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - SysTick clock ticks elapsed since the first SysTick_Init
+ * Description: Function to read the 64-bit monotonic SysTick time with
+ * single clock tick resolution. The wrap time kept by SysTick_Handler is
+ * combined with SYSTICK_CURRENT_REG using a retry loop on a sequence count
+ * the timebase updates bump, so it can be called from the main loop or any
+ * ISR without masking interrupts. An ISR that preempts SysTick_Handler
+ * before it accounted its wrap (COUNTFLAG still set) accounts the wrap
+ * itself in a short masked section, so the time never steps back
+ * whatever the caller priority.
+ * ********************************************************************/
+uint64 SysTick_GetTicks64(void);
+
+
+/*********************************************************************
+ * Service Name: SysTick_GetMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - Microseconds elapsed since the first SysTick_Init
+ * Description: Function to read the monotonic SysTick time in microseconds.
+ * ********************************************************************/
+uint64 SysTick_GetMicros(void);
+
+
+/*********************************************************************
+ * Service Name: SysTick_GetCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Core (and SysTick) clock frequency in Hz
+ * Description: Function to get the core clock frequency used for all
+ * period conversions. It is derived once from SYSCTL_RCC_REG,
+ * SYSCTL_RCC2_REG and the PLL registers and cached, call
+ * SysTick_UpdateCoreClock after changing the clock tree. After
+ * SysTick_Calibrate it is the measured frequency.
+ * ********************************************************************/
+uint32 SysTick_GetCoreClock(void);
+
+
+/*********************************************************************
+ * Service Name: SysTick_UpdateCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the running period can not be generated at the new clock
+ * Description: Function to re-derive the core clock right after the
+ * application changed the clock tree (e.g. switched to the 80 MHz PLL).
+ * A running timer is reprogrammed with the period it was started with,
+ * the monotonic time is rescaled to the new tick rate and the clock
+ * change call-back runs so users can rescale their own tick values.
+ * ********************************************************************/
+Std_ReturnType SysTick_UpdateCoreClock(void);
+
+
+/*********************************************************************
+ * Service Name: SysTick_Calibrate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_WindowSeconds - Measurement window (1 .. SYSTICK_CALIBRATION_MAX_SECONDS)
+ * Parameters (inout): None
+ * Parameters (out): a_ErrorPpm - Measured core clock deviation from the nominal clock in ppm, may be NULL_PTR
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the timer does not run or the reference is missing
+ * Description: Function to measure the real SysTick (core) clock against
+ * the 32.768 kHz crystal of the hibernation RTC, which it starts if
+ * needed. It busy waits for the window with the interrupts enabled and
+ * the timer running (SysTick_Init). The measured frequency replaces the
+ * nominal one, so periods, the monotonic time and the clock change
+ * call-back all use it, and periods that are not a whole number of
+ * clocks are generated with a fractional reload. SysTick_UpdateCoreClock
+ * keeps the calibration until the clock tree changes.
+ * ********************************************************************/
+Std_ReturnType SysTick_Calibrate(uint32 a_WindowSeconds, sint32 *a_ErrorPpm);
+
+
+/*********************************************************************
+ * Service Name: SysTick_SetClockChangeCallBack
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Ptr2Func - Function called with the old and new clock in Hz
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to setup the call back executed by
+ * SysTick_UpdateCoreClock when the core clock frequency changed.
+ * ********************************************************************/
+void SysTick_SetClockChangeCallBack(void (*Ptr2Func) (uint32 a_OldClockHz, uint32 a_NewClockHz));
+
+
+/*********************************************************************
+ * Service Name: SysTick_EnterTicklessIdle
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_GetIdleTicks - Function returning the number of ticks until the
+ *                                   next pending deadline (e.g. SwTimer_GetTicksToNextExpiry)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to put the core to sleep (WFI) until the next
+ * deadline without waking on every tick. It is called from the idle loop
+ * instead of a plain WFI. The ticks skipped during the sleep are replayed
+ * through the subscriber table before the function returns, subscribers
+ * that a_GetIdleTicks does not account for run late, at wake-up. A
+ * fractional period keeps its exact average across the sleeps.
+ * ********************************************************************/
+void SysTick_EnterTicklessIdle(uint32 (*a_GetIdleTicks)(void));
+
+
+/*********************************************************************
+ * Service Name: SysTick_Idle
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to sleep (WFI) until the next interrupt, called
+ * from the idle loop instead of a plain WFI. The sleep runs with
+ * interrupts masked and is accounted as idle time for the CPU load
+ * before the handler that woke the core runs. It may be called with
+ * interrupts already masked, after checking there is no work left.
+ * ********************************************************************/
+void SysTick_Idle(void);
+
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+/*********************************************************************
+ * Service Name: SysTick_GetCpuLoad
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Window - Averaging window
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Busy time in per mille (0 .. 1000) of the window
+ * Description: Function to read the CPU load. Time outside SysTick_Idle
+ * and SysTick_EnterTicklessIdle counts as busy. SysTick_Handler publishes
+ * the figures once per second, so the read is a single word load. A
+ * tickless sleep longer than a second counts as one window.
+ * ********************************************************************/
+uint32 SysTick_GetCpuLoad(SysTick_LoadWindowType a_Window);
+#endif
+
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+/*********************************************************************
+ * Service Name: SysTick_GetOverrunStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the overrun statistics
+ * Return value: None
+ * Description: Function to read a consistent copy of the late and lost
+ * tick counters and the worst call-back duration. Lost ticks are
+ * estimated from the DWT cycle counter, which SysTick_InitPeriod starts.
+ * ********************************************************************/
+void SysTick_GetOverrunStats(SysTick_OverrunStatsType *a_Stats);
+
+
+/*********************************************************************
+ * Service Name: SysTick_ResetOverrunStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the overrun statistics.
+ * ********************************************************************/
+void SysTick_ResetOverrunStats(void);
+
+
+/*********************************************************************
+ * Service Name: SysTick_SetOverrunHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Hook - Function called with the call-back run time in clocks, NULL_PTR to remove it
+ *                  a_BudgetCycles - Allowed call-back run time per tick in clocks, 0 for one tick period
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to setup the hook executed in the SysTick
+ * handler when the call-backs due at a tick ran longer than the budget.
+ * ********************************************************************/
+void SysTick_SetOverrunHook(void (*a_Hook)(uint32 a_CallBackCycles), uint32 a_BudgetCycles);
+#endif
+
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+/*********************************************************************
+ * Service Name: SysTick_GetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the handler entry latency statistics
+ * Return value: None
+ * Description: Function to read a consistent copy of the latency
+ * histogram, min, max and mean (e.g. for a debug dump).
+ * ********************************************************************/
+void SysTick_GetLatencyStats(SysTick_LatencyStatsType *a_Stats);
+
+
+/*********************************************************************
+ * Service Name: SysTick_ResetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the latency statistics.
+ * ********************************************************************/
+void SysTick_ResetLatencyStats(void);
+#endif
+
+
 #endif /* SYSTICK_H_ */
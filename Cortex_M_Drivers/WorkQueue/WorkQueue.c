@@ -0,0 +1,180 @@
+ /******************************************************************************
+ *
+ * Module: WorkQueue
+ *
+ * File Name: WorkQueue.c
+ *
+ * Description: Source file for the deferred work queue drained in the
+ *              lowest priority PendSV exception
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "WorkQueue.h"
+#include "NVIC/NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    void (*Work)(void *Arg);
+    void  *Arg;
+    boolean Ready;                      // Set by the producer once Work and Arg are written.
+}WorkQueue_ItemType;
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+static volatile WorkQueue_ItemType g_ring[WORKQUEUE_SIZE];
+
+/* Free running indexes: producers only move the head, PendSV only moves the tail */
+static volatile uint32 g_head    = 0;
+static volatile uint32 g_tail    = 0;
+static volatile uint32 g_dropped = 0;
+
+/* Implemented in WorkQueue_Asm.asm */
+extern uint32 WorkQueue_ClaimSlot(volatile uint32 *Head, volatile uint32 *Tail, uint32 Size);
+extern void WorkQueue_AtomicIncrement(volatile uint32 *Counter);
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the queue and give PendSV the lowest
+ * priority, so the queued work is preempted by every interrupt.
+ * PendSV_Handler must be in the PendSV slot of the vector table.
+ * ********************************************************************/
+void WorkQueue_Init(void)
+{
+    uint32 i;
+
+    for(i = 0; i < WORKQUEUE_SIZE; i++)
+    {
+        g_ring[i].Ready = FALSE;
+    }
+
+    g_head    = 0;
+    g_tail    = 0;
+    g_dropped = 0;
+
+    NVIC_SetPriorityException(EXCEPTION_PEND_SV_TYPE, EXCEPTION_PRIORITY_LEVEL_7);
+}
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_Post
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run in PendSV
+ *                  Arg - Argument passed to the work function
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if queued, E_NOT_OK if the queue is full
+ * Description: Function to defer work from an ISR (or thread code). The
+ * items run in post order once no other exception is active.
+ * ********************************************************************/
+Std_ReturnType WorkQueue_Post(void (*Work)(void *Arg), void *Arg)
+{
+#if (NVIC_PENDSV_OWNER != NVIC_PENDSV_WORKQUEUE)
+    (void)Work;
+    (void)Arg;
+    return E_NOT_OK;                                    // The Kernel owns PendSV, nothing would drain the queue.
+#else
+    uint32 slot;
+
+    if(Work == NULL_PTR)
+    {
+        return E_NOT_OK;
+    }
+
+    /* Producers at different priorities preempt each other: the head is claimed with
+     * LDREX/STREX and the slot is handed to PendSV by its Ready flag, nothing is masked */
+    slot = WorkQueue_ClaimSlot(&g_head, &g_tail, WORKQUEUE_SIZE);
+
+    if(slot == WORKQUEUE_SIZE)
+    {
+        WorkQueue_AtomicIncrement(&g_dropped);
+        return E_NOT_OK;
+    }
+
+    g_ring[slot].Work  = Work;
+    g_ring[slot].Arg   = Arg;
+    __asm(" DMB");                                      // The item is complete before it is marked ready.
+    g_ring[slot].Ready = TRUE;
+
+    NVIC_SYSTEM_INTCTRL = NVIC_INTCTRL_PEND_SV_MASK;    // Write-one-to-set, the other bits ignore 0.
+
+    return E_OK;
+#endif
+}
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_GetDropped
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Posts rejected because the queue was full
+ * Description: Function to check if WORKQUEUE_SIZE is large enough.
+ * ********************************************************************/
+uint32 WorkQueue_GetDropped(void)
+{
+    return g_dropped;
+}
+
+
+/*********************************************************************
+ * Service Name: PendSV_Handler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: PendSV exception handler that runs the queued work.
+ * Items posted while it runs are taken in the same pass, it stops at a
+ * slot that is claimed but not ready yet.
+ * ********************************************************************/
+void PendSV_Handler(void)
+{
+    uint32 tail = g_tail;
+    uint32 slot;
+    void (*work)(void *Arg);
+    void  *arg;
+
+    while(tail != g_head)
+    {
+        slot = tail & WORKQUEUE_MASK;
+
+        if(!g_ring[slot].Ready)
+        {
+            break;                                      // Thread code claimed it and was preempted, it pends PendSV again once the item is filled.
+        }
+
+        work = g_ring[slot].Work;
+        arg  = g_ring[slot].Arg;
+        g_ring[slot].Ready = FALSE;
+        g_tail = ++tail;                                // Free the slot before the work runs, it may post again.
+        work(arg);
+    }
+}
@@ -0,0 +1,94 @@
+ /******************************************************************************
+ *
+ * Module: WorkQueue
+ *
+ * File Name: WorkQueue.h
+ *
+ * Description: Header file for the deferred work queue drained in the
+ *              lowest priority PendSV exception
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef WORKQUEUE_H_
+#define WORKQUEUE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define WORKQUEUE_SIZE                   16                                     // Work items waiting at most, must be a power of 2.
+#define WORKQUEUE_MASK                   (WORKQUEUE_SIZE - 1)
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to empty the queue and give PendSV the lowest
+ * priority, so the queued work is preempted by every interrupt.
+ * NVIC_PENDSV_OWNER must select NVIC_PENDSV_WORKQUEUE so the startup
+ * file installs PendSV_Handler.
+ * ********************************************************************/
+void WorkQueue_Init(void);
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_Post
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Work - Function to run in PendSV
+ *                  Arg - Argument passed to the work function
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if queued, E_NOT_OK if the queue is full or the Kernel owns PendSV
+ * Description: Function to defer work from an ISR (or thread code). The
+ * items run in post order once no other exception is active. It is
+ * lock-free: the slot is claimed with LDREX/STREX (WorkQueue_Asm.asm)
+ * and published by a per slot ready flag, so it never masks interrupts.
+ * ********************************************************************/
+Std_ReturnType WorkQueue_Post(void (*Work)(void *Arg), void *Arg);
+
+
+/*********************************************************************
+ * Service Name: WorkQueue_GetDropped
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Posts rejected because the queue was full
+ * Description: Function to check if WORKQUEUE_SIZE is large enough.
+ * ********************************************************************/
+uint32 WorkQueue_GetDropped(void);
+
+
+/*********************************************************************
+ * Service Name: PendSV_Handler
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: PendSV exception handler that runs the queued work.
+ * ********************************************************************/
+void PendSV_Handler(void);
+
+
+#endif /* WORKQUEUE_H_ */
@@ -16,18 +16,49 @@
 #include "tm4c123gh6pm_registers.h"
 #include "NVIC/NVIC.h"
 #include "SysTick/SysTick.h"
+#include "Kernel/Kernel.h"
 
-/* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
-#define Enable_Exceptions()    __asm(" CPSIE I ")
+#if (KERNEL_BENCHMARK == TRUE)
 
-/* Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK. */
-#define Disable_Exceptions()   __asm(" CPSID I ")
+#if (NVIC_PENDSV_OWNER != NVIC_PENDSV_KERNEL)
+#error "KERNEL_BENCHMARK needs NVIC_PENDSV_OWNER set to NVIC_PENDSV_KERNEL in NVIC_Cfg.h"
+#endif
 
-/* Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK */
-#define Enable_Faults()        __asm(" CPSIE F ")
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
 
-/* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
-#define Disable_Faults()       __asm(" CPSID F ")
+#define BENCH_STACK_WORDS       128
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+static Kernel_ThreadType g_benchThread;
+static uint32 g_benchStack[BENCH_STACK_WORDS];
+
+/* Read them in the debugger once the benchmark thread sleeps */
+volatile uint32  g_switchCycles       = 0;
+volatile boolean g_switchWithinBudget = FALSE;
+
+/*********************************************************************
+ * Description: Thread that measures the context switch and checks it
+ * against KERNEL_BENCHMARK_MAX_CYCLES, 0 cycles (no DWT) is a failure.
+ * ********************************************************************/
+static void Bench_Thread(void *Arg)
+{
+    (void)Arg;
+
+    g_switchCycles       = Kernel_BenchmarkSwitch();
+    g_switchWithinBudget = (g_switchCycles != 0) && (g_switchCycles < KERNEL_BENCHMARK_MAX_CYCLES);
+
+    for(;;)
+    {
+        Kernel_Sleep(1000);
+    }
+}
+
+#endif
 
 /*******************************************************************************
  *                               Main Program                                  *
@@ -37,5 +68,17 @@
 
 int main(void)
 {
+#if (KERNEL_BENCHMARK == TRUE)
+    SysTick_Init(1);
+
+    if( (Kernel_Init() == E_OK) &&
+        (Kernel_CreateThread(&g_benchThread, Bench_Thread, NULL_PTR, g_benchStack, BENCH_STACK_WORDS, 0) == E_OK) )
+    {
+        Kernel_Start();
+    }
+
+    for(;;);
+#else
     return 0;
+#endif
 }
@@ -26,6 +26,12 @@
 
 #define NULL_PTR    ((void*)0)
 
+/* Standard return type for services that can fail */
+typedef unsigned char         Std_ReturnType;
+
+#define E_OK        ((Std_ReturnType)0x00u)
+#define E_NOT_OK    ((Std_ReturnType)0x01u)
+
 typedef unsigned char         uint8;          /*           0 .. 255              */
 typedef signed char           sint8;          /*        -128 .. +127             */
 typedef unsigned short        uint16;         /*           0 .. 65535            */
@@ -38,6 +38,7 @@ SECTIONS
     .vtable :   > 0x20000000
     .data   :   > SRAM
     .bss    :   > SRAM
+    .TI.noinit : > SRAM, type = NOINIT      /* #pragma NOINIT data (Fault record), kept across resets */
     .sysmem :   > SRAM
     .stack  :   > SRAM
 }
@@ -23,6 +23,7 @@
 //*****************************************************************************
 
 #include <stdint.h>
+#include "NVIC/NVIC_Cfg.h"
 
 //*****************************************************************************
 //
@@ -31,7 +32,6 @@
 //*****************************************************************************
 void ResetISR(void);
 static void NmiSR(void);
-static void FaultISR(void);
 static void IntDefaultHandler(void);
 
 //*****************************************************************************
@@ -56,6 +56,15 @@ extern uint32_t __STACK_TOP;
 //*****************************************************************************
 // To be added by user
 extern void SysTick_Handler(void);
+extern void Fault_Handler(void);
+extern void Fault_Capture(const uint32_t *Frame, uint32_t ExcReturn);
+#if (NVIC_PENDSV_OWNER == NVIC_PENDSV_KERNEL)
+extern void Kernel_PendSVHandler(void);
+#define PENDSV_VECTOR                           Kernel_PendSVHandler
+#else
+extern void PendSV_Handler(void);
+#define PENDSV_VECTOR                           PendSV_Handler
+#endif
 
 //*****************************************************************************
 //
@@ -71,10 +80,10 @@ void (* const g_pfnVectors[])(void) =
                                             // The initial stack pointer
     ResetISR,                               // The reset handler
     NmiSR,                                  // The NMI handler
-    FaultISR,                               // The hard fault handler
-    IntDefaultHandler,                      // The MPU fault handler
-    IntDefaultHandler,                      // The bus fault handler
-    IntDefaultHandler,                      // The usage fault handler
+    Fault_Handler,                          // The hard fault handler
+    Fault_Handler,                          // The MPU fault handler
+    Fault_Handler,                          // The bus fault handler
+    Fault_Handler,                          // The usage fault handler
     0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
@@ -82,7 +91,7 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // SVCall handler
     IntDefaultHandler,                      // Debug monitor handler
     0,                                      // Reserved
-    IntDefaultHandler,                      // The PendSV handler
+    PENDSV_VECTOR,                          // The PendSV handler (NVIC_PENDSV_OWNER)
     SysTick_Handler,                        // The SysTick handler
     IntDefaultHandler,                      // GPIO Port A
     IntDefaultHandler,                      // GPIO Port B
@@ -264,38 +273,15 @@ NmiSR(void)
     }
 }
 
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-
 //*****************************************************************************
 //
 // This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
+// interrupt.  This records the active vector in the crash record and resets
+// the system, Fault_GetLastRecord reports it on the next boot.
 //
 //*****************************************************************************
 static void
 IntDefaultHandler(void)
 {
-    //
-    // Go into an infinite loop.
-    //
-    while(1)
-    {
-    }
+    Fault_Capture(0, 0);
 }
@@ -1,30 +1,31 @@
 #include "SysTick/SysTick.h"
 #include "NVIC/NVIC.h"
+#include "Fault/Fault.h"
+#include "DWT/DWT.h"
+#include "WorkQueue/WorkQueue.h"
+#include "Scheduler/Scheduler.h"
 #include "tm4c123gh6pm_registers.h"
 
-#define GPIO_PORTF_IRQ_NUM                30
-#define GPIO_PORTF_INTERRUPT_PRIORITY     2
 #define SYSTICK_INTERRUPT_PRIORITY        1
-
-#define NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND 364
+#define LEDS_TASK_PRIORITY                0
 
 /* Global variable to count time in seconds */
 volatile uint8 g_Counter = 0;
 
-void Delay_MS(unsigned long long n)
+/* SW2 work, runs in PendSV below every interrupt so SysTick keeps its timebase meanwhile */
+void SW2_Work(void *Arg)
 {
-    volatile uint64 count = 0;
-    while(count++ < (NUMBER_OF_ITERATIONS_PER_ONE_MILI_SECOND * n) );
+    SysTick_Pause(SYSTICK_PAUSE_INCLUDE_TIME); /* Freeze the LED rotation but keep it locked to wall time */
+    GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x0E; /* Turn on the Red, Blue and Green LEDs */
+    DWT_DelayMs(5000);                    /* Cycle exact at any optimization level and core clock */
+    SysTick_Resume();                     /* Catch up the missed seconds, the schedule does not shift */
 }
 
 /* GPIO PORTF External Interrupt - ISR */
 void GPIOPortF_Handler(void)
 {
-    SysTick_Stop();
-    GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x0E; /* Turn on the Red, Blue and Green LEDs */
-    Delay_MS(5000);
-    SysTick_Start();
     GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
+    WorkQueue_Post(SW2_Work, NULL_PTR);   /* Presses while the queue is full are dropped */
 }
 
 /* Enable PF0 (SW2) and activate external interrupt with falling edge */
@@ -43,10 +44,6 @@ void SW2_Init(void)
     GPIO_PORTF_IEV_REG   &= ~(1<<0);      /* PF0 will detect a falling edge */
     GPIO_PORTF_ICR_REG   |= (1<<0);       /* Clear Trigger flag for PF0 (Interrupt Flag) */
     GPIO_PORTF_IM_REG    |= (1<<0);       /* Enable Interrupt on PF0 pin */
-
-    /* Enable NVIC GPIO PORTF IRQ and set its priority */
-    NVIC_EnableIRQ(GPIO_PORTF_IRQ_NUM);
-    NVIC_SetPriorityIRQ(GPIO_PORTF_IRQ_NUM,GPIO_PORTF_INTERRUPT_PRIORITY);
 }
 
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
@@ -60,7 +57,8 @@ void Leds_Init(void)
     GPIO_PORTF_DATA_REG  &= 0xF1;         /* Clear bit 0, 1 and 2 in Data register to turn off the leds */
 }
 
-void SysTick_CallBackFunc(void)
+/* Periodic task: rotate the LEDs once per SysTick tick (1 second) */
+void Leds_RotateTask(void)
 {
     g_Counter++;
 
@@ -81,6 +79,9 @@ void SysTick_CallBackFunc(void)
 
 int main(void)
 {
+    /* Take over the crash record of the previous run and enable the fault exceptions */
+    Fault_Init();
+
     /* Enable clock for PORTF and wait for clock to start */
     SYSCTL_RCGCGPIO_REG |= 0x20;
     while(!(SYSCTL_PRGPIO_REG & 0x20));
@@ -91,17 +92,27 @@ int main(void)
     /* Initialize the LEDs as GPIO Pins */
     Leds_Init();
 
+    /* Enable the GPIO PORTF IRQ with its priority from NVIC_Cfg.h */
+    NVIC_ApplyConfig();
+
+    /* Start the DWT cycle counter used for delays */
+    DWT_Init();
+
+    /* Run the SW2 work in PendSV at the lowest priority */
+    WorkQueue_Init();
+
     /* Start SysTick Timer to generate interrupt every 1 second */
     SysTick_Init(1000);
     NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,EXCEPTION_PRIORITY_LEVEL_1);
-    SysTick_SetCallBack(SysTick_CallBackFunc);
+
+    /* The SysTick handler only releases the LED task, it runs in the main loop */
+    Scheduler_Init();
+    Scheduler_AddTask(LEDS_TASK_PRIORITY, Leds_RotateTask, 1, 1);
 
     /* Enable Interrupts, Exceptions and Faults */
     Enable_Exceptions();
     Enable_Faults();
 
-    while(1)
-    {
-
-    }
+    /* Run the ready tasks, sleep in between */
+    Scheduler_Run();
 }
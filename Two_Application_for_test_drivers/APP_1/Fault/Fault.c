@@ -0,0 +1,168 @@
+ /******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.c
+ *
+ * Description: Source file for the fault handlers that keep a crash record
+ *              in no-init RAM and reset the system
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "Fault.h"
+#include "NVIC/NVIC.h"
+#include "SysTick/SysTick.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                             Global Variables                                *
+ *******************************************************************************/
+
+/* Not cleared by the C startup code, so it survives the system reset */
+#pragma NOINIT(g_faultRecord)
+static Fault_RecordType g_faultRecord;
+
+static Fault_RecordType g_lastRecord;
+static boolean          g_lastRecordValid = FALSE;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Sum all record words in front of the checksum, so a
+ * power-on RAM pattern is not taken for a crash record.
+ * ********************************************************************/
+static uint32 Fault_Checksum(const Fault_RecordType *Record)
+{
+    const uint32 *word = (const uint32 *)Record;
+    uint32 words = (uint32)( (const uint8 *)&Record->Checksum - (const uint8 *)Record ) / sizeof(uint32);
+    uint32 sum   = 0;
+
+    while(words-- != 0)
+    {
+        sum += *word++;
+    }
+
+    return ~sum;
+}
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Fault_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to call once at startup. It takes over the crash
+ * record of the previous run (if any) and enables the MemManage, Bus and
+ * Usage fault exceptions so they get their own record instead of a
+ * Hard fault.
+ * ********************************************************************/
+void Fault_Init(void)
+{
+    if( (g_faultRecord.Magic == FAULT_RECORD_MAGIC) && (g_faultRecord.Checksum == Fault_Checksum(&g_faultRecord)) )
+    {
+        g_lastRecord      = g_faultRecord;
+        g_lastRecordValid = TRUE;
+    }
+
+    g_faultRecord.Magic = 0;                            // A later reset without a fault must not report this record again.
+
+    NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_BUS_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_USAGE_FAULT_TYPE);
+}
+
+
+/*********************************************************************
+ * Service Name: Fault_GetLastRecord
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Record - Crash record of the previous run
+ * Return value: Std_ReturnType - E_OK if the previous run ended with a fault, E_NOT_OK otherwise
+ * Description: Function to read the crash record found by Fault_Init.
+ * ********************************************************************/
+Std_ReturnType Fault_GetLastRecord(Fault_RecordType *Record)
+{
+    if( (g_lastRecordValid == FALSE) || (Record == NULL_PTR) )
+    {
+        return E_NOT_OK;
+    }
+
+    *Record = g_lastRecord;
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: Fault_Capture
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Frame - Stacked exception frame, NULL_PTR if unknown
+ *                  ExcReturn - EXC_RETURN value of the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to write the crash record and reset the system.
+ * Fault_Handler (Fault_Asm.asm) calls it with the frame of the faulting
+ * stack, IntDefaultHandler calls it for unexpected interrupts.
+ * ********************************************************************/
+void Fault_Capture(const uint32 *Frame, uint32 ExcReturn)
+{
+    Fault_RecordType *record = &g_faultRecord;
+    uint32 cfsr = NVIC_SYSTEM_FAULTSTAT;
+
+    Disable_Exceptions();
+
+    /* A frame that failed to stack or points outside SRAM would fault again while it is read */
+    if( (Frame == NULL_PTR) || (cfsr & (FAULT_CFSR_MSTKERR_MASK | FAULT_CFSR_STKERR_MASK)) ||
+        ((uint32)Frame < FAULT_SRAM_START) || ((uint32)Frame > (FAULT_SRAM_END - 8 * sizeof(uint32))) )
+    {
+        Frame = NULL_PTR;
+    }
+
+    record->R0        = (Frame != NULL_PTR) ? Frame[0] : 0;
+    record->R1        = (Frame != NULL_PTR) ? Frame[1] : 0;
+    record->R2        = (Frame != NULL_PTR) ? Frame[2] : 0;
+    record->R3        = (Frame != NULL_PTR) ? Frame[3] : 0;
+    record->R12       = (Frame != NULL_PTR) ? Frame[4] : 0;
+    record->LR        = (Frame != NULL_PTR) ? Frame[5] : 0;
+    record->PC        = (Frame != NULL_PTR) ? Frame[6] : 0;
+    record->XPSR      = (Frame != NULL_PTR) ? Frame[7] : 0;
+    record->CFSR      = cfsr;
+    record->HFSR      = NVIC_SYSTEM_HFAULTSTAT;
+    record->MMFAR     = NVIC_SYSTEM_MMADDR;
+    record->BFAR      = NVIC_SYSTEM_FAULTADDR;
+    record->ExcReturn = ExcReturn;
+    record->Vector    = NVIC_SYSTEM_INTCTRL & NVIC_INTCTRL_VECACT_MASK;
+    record->Reserved  = 0;
+    record->Ticks     = SysTick_GetTicks64();
+    record->Magic     = FAULT_RECORD_MAGIC;
+    record->Checksum  = Fault_Checksum(record);
+
+    /* Reset right away: the record is all the next boot needs */
+    __asm(" DSB ");
+    NVIC_SYSTEM_APINT = NVIC_APINT_VECTKEY | FAULT_APINT_SYSRESREQ_MASK;
+    __asm(" DSB ");
+
+    while(1)
+    {
+        /* Wait for the reset */
+    }
+}
@@ -0,0 +1,103 @@
+ /******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.h
+ *
+ * Description: Header file for the cooperative run-to-completion task
+ *              scheduler on the SysTick timebase
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define SCHEDULER_MAX_TASKS              32                                     // One ready bit per priority level.
+#define SCHEDULER_MAX_PERIOD             0x7FFFFFFFUL                           // Longest period or offset in ticks.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Task priority, 0 is the most urgent, each task owns its level */
+typedef uint8 Scheduler_PriorityType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the SysTick subscriber table is full
+ * Description: Function to remove all tasks and subscribe the scheduler
+ * tick to every SysTick tick. SysTick_Init sets the tick period.
+ * ********************************************************************/
+Std_ReturnType Scheduler_Init(void);
+
+
+/*********************************************************************
+ * Service Name: Scheduler_AddTask
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Priority - Priority of the task (0 .. SCHEDULER_MAX_TASKS - 1), unique per task
+ *                  Task - Function run to completion in the main loop
+ *                  Period - Ticks between releases, 0 for an event-triggered task
+ *                  Offset - Ticks until the first periodic release, 0 to release the task now
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the priority is used or an argument is invalid
+ * Description: Function to register a periodic or event-triggered task.
+ * Periodic tasks with the same period and different offsets are never
+ * released in the same tick, which spreads their load.
+ * ********************************************************************/
+Std_ReturnType Scheduler_AddTask(Scheduler_PriorityType Priority, void (*Task)(void), uint32 Period, uint32 Offset);
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Activate
+ * Sync/Async: Asynchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Priority - Priority of a registered task
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to release a task from an ISR or another task.
+ * A task released again before it ran still runs once.
+ * ********************************************************************/
+void Scheduler_Activate(Scheduler_PriorityType Priority);
+
+
+/*********************************************************************
+ * Service Name: Scheduler_Run
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None, it does not return
+ * Description: Function to run as the main loop. It runs the most urgent
+ * ready task to completion, then looks again, and sleeps with WFI while
+ * no task is ready.
+ * ********************************************************************/
+void Scheduler_Run(void);
+
+
+#endif /* SCHEDULER_H_ */
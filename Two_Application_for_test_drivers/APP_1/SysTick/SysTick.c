@@ -15,165 +15,2000 @@
  *******************************************************************************/
 
 #include "SysTick.h"
+#include "DWT/DWT.h"
+#include "Critical/Critical.h"
 #include "tm4c123gh6pm_registers.h"
 
 /* #define SYSTICK_PRIORITY_MASK        0x1FFFFFFF
  * #define SYSTICK_INTERRUPT_PRIORITY       3
  * #define SYSTICK_PRIORITY_BITS_POS        29 */
 
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define SYSTICK_READ_CYCLES()            (DWT_CYCCNT_REG)   // Same as DWT_GetCycles, inline for the handler.
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef struct
+{
+    void   (*CallBack)(void);           // Function executed in the SysTick handler when due.
+    uint32   Divider;                   // Run the call-back every Divider ticks.
+    uint32   NextDueTick;               // Value of g_tickCount at the next run.
+}SysTick_SubscriberType;
+
 /*******************************************************************************
  *                             Global Variables                                *
  *******************************************************************************/
 
-static volatile void (*g_callBackPtr)(void) = NULL_PTR;
+static volatile void (*g_callBackPtr)(void) = NULL_PTR;          // Call-back of SysTick_SetCallBack, kept in the subscriber table with divider 1.
+
+static SysTick_SubscriberType g_subscribers[SYSTICK_MAX_SUBSCRIBERS];   // Sorted by next due tick, the first entry is always the next one due.
+static volatile uint32 g_subscribersNumber = 0;
+static volatile uint32 g_tickCount         = 0;                 // Ticks (call-back periods) since start up.
+static volatile uint32 g_nextDueTick       = 0;                 // Due tick of the first subscriber, the only value the handler compares.
+
+static volatile uint64 g_wrapTicks   = 0;        // SysTick clock ticks elapsed up to the most recent counter wrap.
+static volatile uint32 g_reloadTicks = 0;        // SysTick clock ticks in one nominal period (reload value + 1), 0 while not initialized.
+static volatile uint32 g_activeTicks = 0;        // Length of the counter cycle in progress (longer than a period during tickless idle).
+static volatile uint32 g_queuedTicks = 0;        // Length of the cycle the counter loads from SYSTICK_RELOAD_REG at the next wrap.
+static volatile uint32 g_timebaseSequence = 0;   // Bumped by every timebase update, SysTick_GetTicks64 retries when it moves.
+static volatile boolean g_wrapSeen = FALSE;           // COUNTFLAG of a wrap not accounted yet was cleared by reading CTRL.
+static volatile boolean g_wrapAccountedEarly = FALSE; // A reader that preempted SysTick_Handler accounted its wrap, the handler skips it.
+
+static volatile uint32 g_prescaler      = 1;     // Nominal periods per call-back (software prescaler for periods above the 24-bit range).
+static volatile uint32 g_prescalerCount = 0;     // Nominal periods elapsed since the last call-back.
+
+static uint32 g_fractionTicks      = 0;          // Fractional part of the period in 1 / g_fractionUnits ticks, 0 for a whole number of ticks.
+static uint32 g_fractionUnits      = 1;
+static uint32 g_fractionCarry      = 0;          // Fraction carried over, a period with a carry is one tick longer.
+static uint32 g_queuedCarry        = 0;          // Fraction carried into the queued cycle, the grid it is laid out on.
+static uint32 g_activeCarry        = 0;          // Fraction carried into the active cycle, SysTick_Rephase walks the grid from it.
+
+static volatile boolean g_paused = FALSE;                        // SysTick_Pause froze the counter.
+static SysTick_PauseModeType g_pauseMode = SYSTICK_PAUSE_EXCLUDE_TIME;
+static uint32 g_pauseCycles = 0;                                 // DWT timestamp of the pause, used to include the paused time.
+static uint32 g_pauseRtc    = 0;                                 // Hibernation RTC count of the pause (1/32768 s).
+static boolean g_pauseRtcValid = FALSE;                          // The RTC was already counting when the pause started.
+static uint32 g_rephaseTailCycles = 0;                           // Clocks the last re-phase kept the counter stopped after its final measurement.
+
+static uint32 g_coreClockHz = 0;                                 // Cached core clock frequency, 0 until derived from the clock registers.
+static uint32 g_nominalClockHz = 0;                              // Clock derived from the clock registers, differs from g_coreClockHz after a calibration.
+static uint32 g_period      = 0;                                 // Period of the last SysTick_InitPeriod, reprogrammed when the clock changes.
+static SysTick_TimeUnitType g_periodUnit = SYSTICK_UNIT_MILLI_SECONDS;
+static void (*g_clockChangeCallBackPtr)(uint32 a_OldClockHz, uint32 a_NewClockHz) = NULL_PTR;
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+static volatile uint32 g_cpuLoad[SYSTICK_LOAD_WINDOWS];          // Published per mille loads, written once per second by SysTick_Handler.
+static volatile uint64 g_idleTicks    = 0;                       // SysTick clock ticks slept since the window started.
+static uint64 g_loadWindowStart       = 0;                       // Monotonic time the current window started.
+static uint32 g_loadWindowTicks       = 0xFFFFFFFFUL;            // Window length, one second of SysTick clock.
+static uint16 g_loadHistory[SYSTICK_CPU_LOAD_HISTORY];           // Load of the last windows, oldest at g_loadIndex once full.
+static uint32 g_loadIndex             = 0;
+static uint32 g_loadSamples           = 0;
+static uint32 g_loadSum10             = 0;
+static uint32 g_loadSum60             = 0;
+#endif
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+static SysTick_OverrunStatsType g_overrunStats = {0, 0, 0};
+static void (*g_overrunHookPtr)(uint32 a_CallBackCycles) = NULL_PTR;
+static uint32 g_overrunBudget = 0;                               // Call-back budget in clocks, 0 for one tick period.
+#endif
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+static SysTick_LatencyStatsType g_latencyStats = {0, 0xFFFFFFFFUL, 0, 0, 0, {0}};
+#endif
+
+/* Main oscillator frequency for each RCC XTAL field value */
+static const uint32 g_crystalHz[] =
+{
+    1000000,  1843200,  2000000,  2457600,  3579545,  3686400,  4000000,  4096000,
+    4915200,  5000000,  5120000,  6000000,  6144000,  7372800,  8000000,  8192000,
+    10000000, 12000000, 12288000, 13560000, 14318180, 16000000, 16384000, 18000000,
+    20000000, 24000000, 25000000
+};
 
 /*******************************************************************************
- *                          Functions Definitions                              *
+ *                      Private Functions Definitions                          *
  *******************************************************************************/
 
+/*********************************************************************
+ * Description: Queue the next nominal period: the reload length, plus
+ * one tick whenever the carried fraction reaches a whole tick, so the
+ * average period is exact. Without a fraction it queues the reload
+ * length.
+ * ********************************************************************/
+static void SysTick_QueuePeriod(void)
+{
+    uint32 next = g_reloadTicks;
+
+    g_queuedCarry    = g_fractionCarry;
+    g_fractionCarry += g_fractionTicks;
+    if(g_fractionCarry >= g_fractionUnits)
+    {
+        g_fractionCarry -= g_fractionUnits;
+        next++;
+    }
+
+    SYSTICK_RELOAD_REG = next - 1;
+    g_queuedTicks      = next;
+}
+
+
+/*********************************************************************
+ * Description: Called from the handler right after the wrap: the
+ * counter started the queued cycle, so its carry becomes the active
+ * one, and the cycle after it is queued. A long tickless cycle in the
+ * queue is left alone.
+ * ********************************************************************/
+static void SysTick_QueueFractionalReload(void)
+{
+    g_activeCarry = g_queuedCarry;
+
+    if( (g_queuedTicks != g_reloadTicks) && (g_queuedTicks != (g_reloadTicks + 1)) )
+    {
+        return;
+    }
+
+    SysTick_QueuePeriod();
+}
+
+
+/*********************************************************************
+ * Description: Account the counter wrap that started the active cycle,
+ * the counter has just loaded the queued cycle. Reading CTRL clears
+ * COUNTFLAG, so a set COUNTFLAG (or g_wrapSeen) always means a wrap
+ * nobody accounted yet. Called with interrupts masked.
+ * ********************************************************************/
+static void SysTick_AccountWrap(void)
+{
+    (void) SYSTICK_CTRL_REG;                                                // Clear COUNTFLAG, this wrap is accounted.
+    g_wrapSeen    = FALSE;
+
+    g_wrapTicks  += g_activeTicks;                                          // Account the elapsed cycle before anyone can read the time.
+    g_activeTicks = g_queuedTicks;                                          // The counter has just loaded the queued cycle.
+    g_timebaseSequence++;
+
+    if(g_fractionTicks != 0)
+    {
+        SysTick_QueueFractionalReload();                                    // Only for periods that are not a whole number of ticks.
+    }
+}
+
+
+/*********************************************************************
+ * Description: Read SYSTICK_CTRL_REG for its control bits. The read
+ * clears COUNTFLAG, a wrap it reports is kept in g_wrapSeen until
+ * the wrap is accounted.
+ * ********************************************************************/
+static uint32 SysTick_ReadCtrl(void)
+{
+    Critical_StateType state = Critical_Enter();
+    uint32 ctrl = SYSTICK_CTRL_REG;
+
+    if(ctrl & SYSTICK_CTRL_COUNT_FLAG_MASK)
+    {
+        g_wrapSeen = TRUE;
+    }
+
+    Critical_Exit(state);
+
+    return ctrl;
+}
+
+
+/*********************************************************************
+ * Description: The caller preempted SysTick_Handler (active but not
+ * the running exception). If it did so before the handler accounted
+ * the wrap that started it (COUNTFLAG still set and no further wrap
+ * pending), account the wrap here and let the handler skip it, so the
+ * time read by the caller never steps back.
+ * ********************************************************************/
+static void SysTick_CatchUpWrap(void)
+{
+    Critical_StateType state = Critical_Enter();
+
+    if( (NVIC_SYSTEM_SYSHNDCTRL & SYSTICK_SYSHNDCTRL_TICKACT_MASK) &&
+        ((NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_VECTACTIVE_MASK) != SYSTICK_EXCEPTION_NUMBER) &&
+        !(NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK) &&
+        ( g_wrapSeen || (SYSTICK_CTRL_REG & SYSTICK_CTRL_COUNT_FLAG_MASK) ) )
+    {
+        SysTick_AccountWrap();
+        g_wrapAccountedEarly = TRUE;
+    }
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Description: Stop the SysTick counter and fold the part of the
+ * current period that already elapsed (and a wrap that is still
+ * pending) into g_wrapTicks, so reconfiguring the timer never makes
+ * the monotonic time jump backwards.
+ * ********************************************************************/
+static void SysTick_SyncTimebase(void)
+{
+    Critical_StateType state = Critical_Enter();                            // Keep SysTick_Handler out while the timebase is moved.
+    uint32 current;
+
+    SysTick_CatchUpWrap();                                                  // Caller may have preempted the handler before it accounted its wrap.
+
+    SYSTICK_CTRL_REG = 0;                                                   // Freeze the counter.
+
+    if(g_reloadTicks != 0)
+    {
+        if(NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK)
+        {
+            g_wrapTicks  += g_activeTicks;                                  // Account the wrap the handler did not see yet.
+            g_activeTicks = g_queuedTicks;
+            NVIC_SYSTEM_INTCTRL = SYSTICK_INTCTRL_PENDSTCLR_MASK;           // And make sure it will not be counted twice.
+        }
+
+        current = SYSTICK_CURRENT_REG;
+        if(current != 0)
+        {
+            g_wrapTicks += g_activeTicks - current;                         // Part of the current cycle that already elapsed.
+        }
+
+        g_reloadTicks = 0;                                                  // Time holds still until the timer is configured again.
+        g_activeTicks = 0;
+        g_queuedTicks = 0;
+        g_timebaseSequence++;
+    }
+
+    (void) SYSTICK_CTRL_REG;                                                // Every wrap is accounted, clear COUNTFLAG.
+    g_wrapSeen = FALSE;
+
+    g_paused = FALSE;                                                       // A new configuration ends a pause.
+
+    Critical_Exit(state);
+}
+
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+/*********************************************************************
+ * Description: Accumulate one handler entry latency. The counter loaded
+ * a_CycleTicks - 1 at the wrap, so the clocks it counted down since then
+ * are the time the handler was late.
+ * ********************************************************************/
+static void SysTick_RecordLatency(uint32 a_CycleTicks, uint32 a_Current)
+{
+    uint32 latency;
+
+    if(a_Current > (a_CycleTicks - 1))
+    {
+        return;                                                             // Counter reconfigured meanwhile, not a valid sample.
+    }
+
+    latency = (a_CycleTicks - 1) - a_Current;
+
+    g_latencyStats.Samples++;
+    g_latencyStats.Sum += latency;
+    if(latency < g_latencyStats.Min)
+    {
+        g_latencyStats.Min = latency;
+    }
+    if(latency > g_latencyStats.Max)
+    {
+        g_latencyStats.Max = latency;
+    }
+    g_latencyStats.Histogram[32 - _norm(latency)]++;                        // Index is the bit length of the latency (CLZ), always < 25 for 24-bit counts.
+}
+#endif
+
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+/*********************************************************************
+ * Description: Close the one second window that just ended: turn its
+ * idle time into a per mille load and update the rolling 10 s and 60 s
+ * sums. Runs in SysTick_Handler once per second.
+ * ********************************************************************/
+static void SysTick_UpdateCpuLoad(void)
+{
+    uint64 now    = g_wrapTicks;
+    uint64 window = now - g_loadWindowStart;
+    uint64 idle   = g_idleTicks;                                            // Idle time is added with interrupts masked, never under this read.
+    uint32 load;
+
+    g_idleTicks       = 0;
+    g_loadWindowStart = now;
+
+    load = (idle >= window) ? 0 : (uint32) ( ((window - idle) * 1000) / window );
+
+    if(g_loadSamples >= 10)
+    {
+        g_loadSum10 -= g_loadHistory[(g_loadIndex + SYSTICK_CPU_LOAD_HISTORY - 10) % SYSTICK_CPU_LOAD_HISTORY];
+    }
+    if(g_loadSamples >= SYSTICK_CPU_LOAD_HISTORY)
+    {
+        g_loadSum60 -= g_loadHistory[g_loadIndex];
+    }
+    else
+    {
+        g_loadSamples++;
+    }
+
+    g_loadHistory[g_loadIndex] = (uint16) load;
+    g_loadSum10 += load;
+    g_loadSum60 += load;
+    g_loadIndex  = (g_loadIndex + 1) % SYSTICK_CPU_LOAD_HISTORY;
+
+    g_cpuLoad[SYSTICK_LOAD_1S]  = load;
+    g_cpuLoad[SYSTICK_LOAD_10S] = g_loadSum10 / ( (g_loadSamples < 10) ? g_loadSamples : 10 );
+    g_cpuLoad[SYSTICK_LOAD_60S] = g_loadSum60 / g_loadSamples;
+}
+
+
+/*********************************************************************
+ * Description: Restart the current load window, e.g. after the
+ * timebase was rescaled to a new clock.
+ * ********************************************************************/
+static void SysTick_ResetCpuLoad(void)
+{
+    g_idleTicks       = 0;
+    g_loadWindowStart = g_wrapTicks;
+    g_loadWindowTicks = SysTick_GetCoreClock();
+}
+#endif
+
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+/*********************************************************************
+ * Description: Record the handler run time of a tick with due
+ * call-backs and call the overrun hook when it is over budget.
+ * ********************************************************************/
+static void SysTick_RecordCallBackTime(uint32 a_Cycles)
+{
+    uint64 budget = (g_overrunBudget != 0) ? g_overrunBudget : ((uint64) g_reloadTicks * g_prescaler);
+
+    if(a_Cycles > g_overrunStats.WorstCallBackCycles)
+    {
+        g_overrunStats.WorstCallBackCycles = a_Cycles;
+    }
+
+    if( (a_Cycles > budget) && (g_overrunHookPtr != NULL_PTR) )
+    {
+        g_overrunHookPtr(a_Cycles);
+    }
+}
+
+
+/*********************************************************************
+ * Description: The next tick became pending while the handler ran. The
+ * counter loaded a_CycleTicks - 1 at the wrap that started the handler
+ * (a_Current was sampled at entry), so the clocks since that wrap tell
+ * how many more wraps passed; only one of them can be pending, the
+ * others were lost.
+ * ********************************************************************/
+static void SysTick_RecordOverrun(uint32 a_CycleTicks, uint32 a_Current, uint32 a_HandlerCycles)
+{
+    uint32 sinceWrap;
+
+    g_overrunStats.LateTicks++;
+
+    if(a_Current <= (a_CycleTicks - 1))
+    {
+        sinceWrap = (a_CycleTicks - 1) - a_Current + a_HandlerCycles;
+        if( (sinceWrap / a_CycleTicks) > 1 )
+        {
+            g_overrunStats.LostTicks += (sinceWrap / a_CycleTicks) - 1;
+        }
+    }
+}
+#endif
+
+
+/*********************************************************************
+ * Description: Whole ticks the fraction adds to the next a_Periods
+ * nominal periods, the carry moves past them.
+ * ********************************************************************/
+static uint32 SysTick_AdvanceFraction(uint32 a_Periods)
+{
+    uint64 sum;
+
+    if(g_fractionTicks == 0)
+    {
+        return 0;
+    }
+
+    sum             = g_fractionCarry + ( (uint64) a_Periods * g_fractionTicks );
+    g_fractionCarry = (uint32) (sum % g_fractionUnits);
+
+    return (uint32) (sum / g_fractionUnits);
+}
+
+
+/*********************************************************************
+ * Description: Clocks from the start of the active cycle to the end of
+ * its a_Periods-th nominal period, on the grid the fractional reload
+ * lays out from g_activeCarry. a_Periods is split at g_fractionUnits so
+ * long pauses can not overflow the product with the fraction.
+ * ********************************************************************/
+static uint64 SysTick_GridTicks(uint64 a_Periods)
+{
+    uint64 ticks = a_Periods * g_reloadTicks;
+
+    if(g_fractionTicks != 0)
+    {
+        ticks += (a_Periods / g_fractionUnits) * g_fractionTicks;
+        ticks += (g_activeCarry + ( (a_Periods % g_fractionUnits) * g_fractionTicks )) / g_fractionUnits;
+    }
+
+    return ticks;
+}
+
+
+/*********************************************************************
+ * Description: Fraction carried past a_Periods nominal periods of the
+ * active cycle (see SysTick_GridTicks).
+ * ********************************************************************/
+static uint32 SysTick_GridCarry(uint64 a_Periods)
+{
+    if(g_fractionTicks == 0)
+    {
+        return 0;
+    }
+
+    return (uint32) ( (g_activeCarry + ( (a_Periods % g_fractionUnits) * g_fractionTicks )) % g_fractionUnits );
+}
+
+
+/*********************************************************************
+ * Description: Switch all conversions to a new core clock frequency.
+ * The timer is stopped, the monotonic time is rescaled to the new tick
+ * rate, a running timer is reprogrammed with its period and the clock
+ * change call-back runs.
+ * ********************************************************************/
+static Std_ReturnType SysTick_ChangeCoreClock(uint32 a_OldClockHz, uint32 a_NewClockHz)
+{
+    Std_ReturnType     status = E_OK;
+    boolean            running;
+    Critical_StateType state;
+
+    state   = Critical_Enter();
+    running = (g_reloadTicks != 0) ? TRUE : FALSE;
+
+    SysTick_SyncTimebase();                                                 // Stop the timer and fold the elapsed part of the period.
+
+    g_wrapTicks   = ( (g_wrapTicks / a_OldClockHz) * a_NewClockHz ) + ( ((g_wrapTicks % a_OldClockHz) * a_NewClockHz) / a_OldClockHz );
+    g_coreClockHz = a_NewClockHz;
+    g_timebaseSequence++;
+
+    if(running)
+    {
+        status = SysTick_InitPeriod(g_period, g_periodUnit, NULL_PTR);
+    }
+
+    Critical_Exit(state);
+
+    if(g_clockChangeCallBackPtr != NULL_PTR)
+    {
+        g_clockChangeCallBackPtr(a_OldClockHz, a_NewClockHz);
+    }
+
+    return status;
+}
+
+
+/*********************************************************************
+ * Description: Read the hibernation RTC as one count of 1/32768 s,
+ * the seconds counter is read twice to catch a carry in between.
+ * ********************************************************************/
+static uint32 SysTick_ReadRtc(void)
+{
+    uint32 seconds;
+    uint32 subSeconds;
+
+    do
+    {
+        seconds    = HIB_RTCC_REG;
+        subSeconds = HIB_RTCSS_REG & HIB_RTCSS_RTCSSC_MASK;
+    } while(seconds != HIB_RTCC_REG);
+
+    return (seconds << HIB_RTCSS_BITS) | subSeconds;
+}
+
+
+/*********************************************************************
+ * Description: Start the hibernation RTC on its 32.768 kHz crystal,
+ * each HIB write waits for the previous one. The oscillator is enabled
+ * on its own first and the RTC only once the write completed, so the
+ * counter never runs on a crystal that is still starting. Returns TRUE
+ * if it was already running.
+ * ********************************************************************/
+static boolean SysTick_StartRtc(void)
+{
+    SYSCTL_RCGCHIB_REG |= SYSCTL_RCGCHIB_R0_MASK;
+    while( !(SYSCTL_PRHIB_REG & SYSCTL_RCGCHIB_R0_MASK) );
+
+    if( (HIB_CTL_REG & (HIB_CTL_CLK32EN_MASK | HIB_CTL_RTCEN_MASK)) == (HIB_CTL_CLK32EN_MASK | HIB_CTL_RTCEN_MASK) )
+    {
+        return TRUE;
+    }
+
+    if( !(HIB_CTL_REG & HIB_CTL_CLK32EN_MASK) )
+    {
+        while( !(HIB_CTL_REG & HIB_CTL_WRC_MASK) );
+        HIB_CTL_REG |= HIB_CTL_CLK32EN_MASK;
+        while( !(HIB_CTL_REG & HIB_CTL_WRC_MASK) );                         // Oscillator enabled, only now may RTCEN be written.
+    }
+
+    while( !(HIB_CTL_REG & HIB_CTL_WRC_MASK) );
+    HIB_CTL_REG |= HIB_CTL_RTCEN_MASK;
+    while( !(HIB_CTL_REG & HIB_CTL_WRC_MASK) );
+
+    return FALSE;
+}
+
+
+/*********************************************************************
+ * Description: SysTick clocks that passed since SysTick_Pause. The RTC
+ * keeps counting through sleep and for any length of pause; the DWT
+ * count is clock exact but stops while the core sleeps and wraps every
+ * 2^32 clocks. The DWT count is extended by the wraps the RTC shows and
+ * used if it agrees with the RTC, else the RTC time is used. Without a
+ * running RTC only the DWT count is available.
+ * ********************************************************************/
+static uint64 SysTick_PausedTicks(void)
+{
+    uint32 cycles  = DWT_GetCycles() - g_pauseCycles;
+    uint32 clockHz = SysTick_GetCoreClock();
+    uint64 rtcTicks;
+    uint64 dwtTicks;
+    uint64 difference;
+    uint64 tolerance;
+
+    if(g_pauseRtcValid == FALSE)
+    {
+        return cycles;
+    }
+
+    rtcTicks = ( (uint64) (SysTick_ReadRtc() - g_pauseRtc) * clockHz ) / SYSTICK_HIB_OSC_HZ;
+    dwtTicks = cycles;
+    if(rtcTicks > dwtTicks)
+    {
+        dwtTicks += ( (rtcTicks - dwtTicks + 0x80000000ULL) >> 32 ) << 32;    // Nearest number of counter wraps.
+    }
+
+    difference = (dwtTicks > rtcTicks) ? (dwtTicks - rtcTicks) : (rtcTicks - dwtTicks);
+    tolerance  = (clockHz / SYSTICK_HIB_OSC_HZ) + 1 + (rtcTicks >> 10);     // One RTC count plus about 0.1 % clock error.
+
+    return (difference <= tolerance) ? dwtTicks : rtcTicks;
+}
+
+
+/*********************************************************************
+ * Description: Busy wait for the next RTC count and return it with the
+ * SysTick time of the edge in a_Ticks. The edge is sampled with the
+ * interrupts masked, the handler runs between the polls. Fails if the
+ * RTC does not count within a_TimeoutTicks.
+ * ********************************************************************/
+static Std_ReturnType SysTick_WaitRtcEdge(uint32 a_From, uint32 *a_Rtc, uint64 *a_Ticks, uint64 a_TimeoutTicks)
+{
+    uint64 start = SysTick_GetTicks64();
+    Critical_StateType state;
+
+    while(1)
+    {
+        state   = Critical_Enter();
+        *a_Rtc  = SysTick_ReadRtc();
+        if(*a_Rtc != a_From)
+        {
+            *a_Ticks = SysTick_GetTicks64();
+            Critical_Exit(state);
+            return E_OK;
+        }
+        Critical_Exit(state);
+
+        if( (SysTick_GetTicks64() - start) > a_TimeoutTicks )
+        {
+            return E_NOT_OK;
+        }
+    }
+}
+
+
+/*********************************************************************
+ * Description: Sleep until the next interrupt, called with interrupts
+ * masked. The time asleep is added to the idle time of the CPU load.
+ * ********************************************************************/
+static void SysTick_Sleep(void)
+{
+#if (SYSTICK_CPU_LOAD == TRUE)
+    uint64 start = SysTick_GetTicks64();
+#endif
+
+    __asm(" DSB ");
+    __asm(" WFI ");
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+    g_idleTicks += SysTick_GetTicks64() - start;
+#endif
+}
+
+
+/*********************************************************************
+ * Description: Derive the system clock frequency from the RCC/RCC2
+ * oscillator source, PLL and divider settings. The PLL output is
+ * MOSC or PIOSC * (MINT + MFRAC / 1024) / ((Q + 1) * (N + 1)), 400 MHz
+ * with the reset values, and is divided by 2 unless DIV400 is used.
+ * ********************************************************************/
+static uint32 SysTick_ReadCoreClock(void)
+{
+    uint32  rcc     = SYSCTL_RCC_REG;
+    uint32  rcc2    = SYSCTL_RCC2_REG;
+    boolean useRcc2 = (rcc2 & SYSCTL_RCC2_USERCC2_MASK) ? TRUE : FALSE;
+    boolean usePll;
+    uint32  oscSource;
+    uint32  crystal;
+    uint32  pllFreq0;
+    uint32  pllFreq1;
+    uint64  clockHz;
+
+    oscSource = useRcc2 ? ((rcc2 & SYSCTL_RCC2_OSCSRC2_MASK) >> SYSCTL_RCC2_OSCSRC2_BITS_POS)
+                        : ((rcc  & SYSCTL_RCC_OSCSRC_MASK)   >> SYSCTL_RCC_OSCSRC_BITS_POS);
+
+    switch(oscSource)
+    {
+        case SYSCTL_OSCSRC_MAIN:
+            crystal = (rcc & SYSCTL_RCC_XTAL_MASK) >> SYSCTL_RCC_XTAL_BITS_POS;
+            clockHz = (crystal < (sizeof(g_crystalHz) / sizeof(g_crystalHz[0]))) ? g_crystalHz[crystal] : 0;
+            break;
+        case SYSCTL_OSCSRC_PIOSC:
+            clockHz = SYSTICK_PIOSC_HZ;
+            break;
+        case SYSCTL_OSCSRC_PIOSC_DIV4:
+            clockHz = SYSTICK_PIOSC_HZ / 4;
+            break;
+        case SYSCTL_OSCSRC_LFIOSC:
+            clockHz = SYSTICK_LFIOSC_HZ;
+            break;
+        case SYSCTL_OSCSRC_HIB_32KHZ:
+            clockHz = SYSTICK_HIB_OSC_HZ;
+            break;
+        default:
+            clockHz = 0;
+            break;
+    }
+
+    usePll = useRcc2 ? !(rcc2 & SYSCTL_RCC2_BYPASS2_MASK) : !(rcc & SYSCTL_RCC_BYPASS_MASK);
+
+    if(usePll)
+    {
+        pllFreq0 = SYSCTL_PLLFREQ0_REG;
+        pllFreq1 = SYSCTL_PLLFREQ1_REG;
+        clockHz  = ( clockHz * ( ((pllFreq0 & SYSCTL_PLLFREQ0_MINT_MASK) * 1024) + ((pllFreq0 & SYSCTL_PLLFREQ0_MFRAC_MASK) >> SYSCTL_PLLFREQ0_MFRAC_BITS_POS) ) ) /
+                   ( 1024ULL * ( ((pllFreq1 & SYSCTL_PLLFREQ1_Q_MASK) >> SYSCTL_PLLFREQ1_Q_BITS_POS) + 1 ) * ( (pllFreq1 & SYSCTL_PLLFREQ1_N_MASK) + 1 ) );
+
+        if( !(useRcc2 && (rcc2 & SYSCTL_RCC2_DIV400_MASK)) )
+        {
+            clockHz /= 2;                                                   // Without DIV400 the system divider works on PLL / 2.
+        }
+    }
+
+    if(rcc & SYSCTL_RCC_USESYSDIV_MASK)
+    {
+        if(useRcc2 && usePll && (rcc2 & SYSCTL_RCC2_DIV400_MASK))
+        {
+            clockHz /= ((rcc2 & SYSCTL_RCC2_SYSDIV2_400_MASK) >> SYSCTL_RCC2_SYSDIV2_400_BITS_POS) + 1;
+        }
+        else if(useRcc2)
+        {
+            clockHz /= ((rcc2 & SYSCTL_RCC2_SYSDIV2_MASK) >> SYSCTL_RCC2_SYSDIV2_BITS_POS) + 1;
+        }
+        else
+        {
+            clockHz /= ((rcc & SYSCTL_RCC_SYSDIV_MASK) >> SYSCTL_RCC_SYSDIV_BITS_POS) + 1;
+        }
+    }
+
+    return (clockHz != 0) ? (uint32) clockHz : SYSTICK_PIOSC_HZ;            // Unknown setting, fall back to the reset clock.
+}
+
+
+/*********************************************************************
+ * Description: Convert SysTick clock ticks to another unit, the division
+ * is split so the product never exceeds 64 bits.
+ * ********************************************************************/
+static uint64 SysTick_TicksToUnits(uint64 a_Ticks, uint32 a_UnitsPerSecond)
+{
+    uint32 clockHz = SysTick_GetCoreClock();
+
+    return ( (a_Ticks / clockHz) * a_UnitsPerSecond ) + ( ((a_Ticks % clockHz) * a_UnitsPerSecond) / clockHz );
+}
+
+
+/*********************************************************************
+ * Description: Convert a period to SysTick clock ticks and split it in
+ * a reload length (at most SYSTICK_MAX_CYCLE_TICKS) and a software
+ * prescaler. The reload length is rounded to the nearest tick, so the
+ * error is at most half a tick per counter wrap. Without a prescaler
+ * the reload length is rounded down instead and the rest of the period
+ * is returned as a fraction for the fractional reload, if requested.
+ * ********************************************************************/
+static Std_ReturnType SysTick_ComputePeriod(uint32 a_Period, SysTick_TimeUnitType a_Unit, uint32 *a_ReloadTicks, uint32 *a_Prescaler,
+                                            uint32 *a_FractionTicks, uint32 *a_FractionUnits)
+{
+    uint64 unitsPerSecond;
+    uint64 exactTicks;
+    uint64 totalTicks;
+    uint64 error;
+    uint64 bestError;
+    uint32 prescaler;
+    uint32 lastPrescaler;
+    uint32 reloadTicks;
+
+    switch(a_Unit)
+    {
+        case SYSTICK_UNIT_NANO_SECONDS:
+            unitsPerSecond = 1000000000ULL;
+            break;
+        case SYSTICK_UNIT_MICRO_SECONDS:
+            unitsPerSecond = 1000000ULL;
+            break;
+        case SYSTICK_UNIT_MILLI_SECONDS:
+            unitsPerSecond = 1000ULL;
+            break;
+        case SYSTICK_UNIT_SECONDS:
+            unitsPerSecond = 1ULL;
+            break;
+        default:
+            return E_NOT_OK;
+    }
+
+    exactTicks = (uint64) a_Period * SysTick_GetCoreClock();                // Period in 1 / unitsPerSecond ticks, can not overflow, both factors are below 2^32.
+    totalTicks = (exactTicks + (unitsPerSecond / 2)) / unitsPerSecond;
+
+    if(totalTicks < SYSTICK_MIN_PERIOD_TICKS)
+    {
+        return E_NOT_OK;                                                    // Shorter than the handler can keep up with (or below one tick).
+    }
+
+    /* Start at the smallest prescaler that fits the counter and try a few larger
+     * ones for a reload length that divides the period with a smaller error */
+    prescaler     = (uint32) ( (totalTicks + SYSTICK_MAX_CYCLE_TICKS - 1) / SYSTICK_MAX_CYCLE_TICKS );
+    lastPrescaler = (prescaler == 1) ? 1 : (prescaler + SYSTICK_PRESCALER_SEARCH_SPAN);
+    bestError     = 0xFFFFFFFFFFFFFFFFULL;
+
+    for( ; (prescaler <= lastPrescaler) && (bestError != 0); prescaler++)
+    {
+        reloadTicks = (uint32) ( (totalTicks + (prescaler / 2)) / prescaler );
+        error       = (uint64) reloadTicks * prescaler;
+        error       = (error > totalTicks) ? (error - totalTicks) : (totalTicks - error);
+
+        if(error < bestError)
+        {
+            bestError      = error;
+            *a_ReloadTicks = reloadTicks;
+            *a_Prescaler   = prescaler;
+        }
+    }
+
+    if(a_FractionTicks != NULL_PTR)
+    {
+        *a_FractionTicks = 0;
+        *a_FractionUnits = (uint32) unitsPerSecond;
+
+        /* A carry period is one tick longer than the reload length, it must still fit the 24-bit
+         * reload register; a period just above the counter range keeps the rounded length */
+        if( (*a_Prescaler == 1) && ((exactTicks / unitsPerSecond) < SYSTICK_MAX_CYCLE_TICKS) )
+        {
+            *a_ReloadTicks   = (uint32) (exactTicks / unitsPerSecond);
+            *a_FractionTicks = (uint32) (exactTicks % unitsPerSecond);
+        }
+    }
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Description: Link a subscriber into the table behind all entries
+ * due earlier or at the same tick (called with interrupts disabled).
+ * ********************************************************************/
+static void SysTick_InsertSubscriber(const SysTick_SubscriberType *a_Subscriber)
+{
+    uint32 now   = g_tickCount;
+    uint32 index = g_subscribersNumber;
+
+    while( (index != 0) && ((g_subscribers[index - 1].NextDueTick - now) > (a_Subscriber->NextDueTick - now)) )
+    {
+        g_subscribers[index] = g_subscribers[index - 1];
+        index--;
+    }
+
+    g_subscribers[index] = *a_Subscriber;
+    g_subscribersNumber++;
+    g_nextDueTick = g_subscribers[0].NextDueTick;
+}
+
+
+/*********************************************************************
+ * Description: Unlink the subscriber at the given table index (called
+ * with interrupts disabled). An empty table parks g_nextDueTick on the
+ * current tick, so the handler compare fails for the next 2^32 ticks.
+ * ********************************************************************/
+static void SysTick_RemoveSubscriber(uint32 a_Index)
+{
+    g_subscribersNumber--;
+
+    for( ; a_Index < g_subscribersNumber; a_Index++)
+    {
+        g_subscribers[a_Index] = g_subscribers[a_Index + 1];
+    }
+
+    g_nextDueTick = (g_subscribersNumber != 0) ? g_subscribers[0].NextDueTick : g_tickCount;
+}
+
+
+/*********************************************************************
+ * Description: Run every subscriber due at the current tick. Each one
+ * is re-queued at its next due tick before its call-back runs, so the
+ * call-back may subscribe or unsubscribe anything, itself included.
+ * ********************************************************************/
+static void SysTick_Dispatch(void)
+{
+    uint32 now = g_tickCount;
+    Critical_StateType state;
+    SysTick_SubscriberType due;
+
+    state = Critical_Enter();                                               // The table is shared with (un)subscribe calls from other ISRs.
+
+    while( (g_subscribersNumber != 0) && (g_subscribers[0].NextDueTick == now) )
+    {
+        due = g_subscribers[0];
+        SysTick_RemoveSubscriber(0);
+        due.NextDueTick += due.Divider;
+        SysTick_InsertSubscriber(&due);
+
+        Critical_Exit(state);
+        due.CallBack();
+        state = Critical_Enter();
+    }
+
+    if(g_subscribersNumber == 0)
+    {
+        g_nextDueTick = now;
+    }
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Description: Dispatch the counter periods that elapsed while the
+ * interrupt was suppressed (through the software prescaler, like the
+ * handler), so tick counting users stay consistent.
+ * ********************************************************************/
+static void SysTick_ReplayTicks(uint32 a_Periods)
+{
+    while(a_Periods != 0)
+    {
+        if(++g_prescalerCount >= g_prescaler)
+        {
+            g_prescalerCount = 0;
+
+            if(++g_tickCount == g_nextDueTick)
+            {
+                SysTick_Dispatch();
+            }
+        }
+        a_Periods--;
+    }
+}
+
+
+/*********************************************************************
+ * Description: End a long tickless cycle early or resume a paused
+ * counter in wall time (called with interrupts disabled). The counter
+ * is stopped, the elapsed whole periods (plus a_ExtraTicks the counter
+ * did not see) are accounted and replayed, and the counter is restarted
+ * with the rest of the current period so the next tick lands on the
+ * original tick grid again. With a fractional period the grid is the
+ * one the fractional reload lays out, so no fraction is lost. The clocks
+ * the counter is stopped for are measured with the DWT cycle counter;
+ * the few stores after the last measurement are taken from the previous
+ * re-phase.
+ * ********************************************************************/
+static void SysTick_Rephase(uint64 a_ExtraTicks)
+{
+    uint32 ctrl;
+    uint32 reload  = g_reloadTicks;
+    uint64 elapsed;
+    uint64 periods;
+    uint64 start;
+    uint32 current;
+    uint32 length;
+    uint32 remaining;
+    uint32 carry;
+    uint32 nextCarry;
+    uint32 stopCycles;
+    uint32 restartCycles;
+    uint32 lostTicks;
+
+    SysTick_CatchUpWrap();                                                  // Caller may have preempted the handler before it accounted its wrap.
+
+    ctrl = SysTick_ReadCtrl();
+    SYSTICK_CTRL_REG = ctrl & ~SYSTICK_CTRL_ENABLE_MASK;                    // Freeze the counter.
+    stopCycles = SYSTICK_READ_CYCLES();
+    current = SYSTICK_CURRENT_REG;
+
+    if(NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK)
+    {
+        /* The long cycle ended meanwhile and the counter already runs the queued period */
+        NVIC_SYSTEM_INTCTRL = SYSTICK_INTCTRL_PENDSTCLR_MASK;
+        elapsed = g_activeTicks + ( (current != 0) ? (g_queuedTicks - current) : 0 );
+    }
+    else
+    {
+        elapsed = g_activeTicks - current;
+    }
+
+    elapsed += a_ExtraTicks;
+
+    /* Last period boundary of the grid at or before elapsed: start from an upper bound (no period
+     * is shorter than the reload length) and step back by the overshoot, periods are at most one
+     * tick longer, so this never steps past the boundary and converges in a few rounds */
+    periods = elapsed / reload;
+    start   = SysTick_GridTicks(periods);
+    while(start > elapsed)
+    {
+        periods -= ( (start - elapsed) + reload ) / (reload + 1);
+        start    = SysTick_GridTicks(periods);
+    }
+
+    carry     = SysTick_GridCarry(periods);                                 // Carried into the period elapsed ends in.
+    nextCarry = carry + g_fractionTicks;
+    length    = reload;
+    if(nextCarry >= g_fractionUnits)
+    {
+        nextCarry -= g_fractionUnits;
+        length++;
+    }
+    remaining = length - (uint32) (elapsed - start);
+
+    /* Clocks the counter missed while frozen (SysTick counts core clocks like CYCCNT) */
+    restartCycles = SYSTICK_READ_CYCLES();
+    lostTicks     = (restartCycles - stopCycles) + g_rephaseTailCycles;
+
+    while(lostTicks >= (remaining - 1))
+    {
+        /* The boundary passed while frozen (only with periods shorter than the stop window)
+         * or is due right now, start the next period fresh */
+        lostTicks  = (lostTicks >= remaining) ? (lostTicks - remaining) : 0;
+        periods++;
+        start     += length;
+        carry      = nextCarry;
+        nextCarry  = carry + g_fractionTicks;
+        length     = reload;
+        if(nextCarry >= g_fractionUnits)
+        {
+            nextCarry -= g_fractionUnits;
+            length++;
+        }
+        remaining  = length;
+    }
+    remaining -= lostTicks;
+
+    g_wrapTicks  += start;
+    g_activeTicks = length;                                                 // The restarted cycle is the tail of a nominal period.
+    g_activeCarry = carry;
+
+    SYSTICK_RELOAD_REG  = remaining - 1;
+    SYSTICK_CURRENT_REG = 0;                                                // Also clears COUNTFLAG, every wrap is accounted.
+    g_wrapSeen          = FALSE;
+    SYSTICK_CTRL_REG    = ctrl | SYSTICK_CTRL_ENABLE_MASK;                  // Restart, the counter loads the rest of the period.
+    g_rephaseTailCycles = SYSTICK_READ_CYCLES() - restartCycles;
+    while(SYSTICK_CURRENT_REG == 0);                                        // Wait until it is loaded before queuing the nominal period.
+    g_fractionCarry     = nextCarry;
+    SysTick_QueuePeriod();
+    g_timebaseSequence++;
+
+    SysTick_ReplayTicks((uint32) periods);
+}
+
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*****************************************************************************
+ * Service Name: SysTick_Init
+ * Sync/Async:
+ * Reentrancy:
+ * Parameters (in): a_TimeInMilliSeconds - Time in MilliSeconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Initialize the SysTick timer with the specified time
+ * in milliseconds using interrupts. This function is used to setup the
+ * timer to generate periodic interrupts every specified time in milliseconds.
+ * ****************************************************************************/
+void SysTick_Init(uint16 a_TimeInMilliSeconds)
+{
+    (void) SysTick_InitPeriod(a_TimeInMilliSeconds, SYSTICK_UNIT_MILLI_SECONDS, NULL_PTR);
+}
+
+
+/*****************************************************************************
+ * Service Name: SysTick_InitPeriod
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Period - Period of the call-back in units of a_Unit
+ *                  a_Unit - Unit of a_Period (ns, us, ms or s)
+ * Parameters (inout): None
+ * Parameters (out): a_AchievedNanoSeconds - Period actually programmed in nanoseconds (may be NULL_PTR)
+ * Return value: Std_ReturnType - E_OK if the timer runs, E_NOT_OK if the period can not be generated
+ * Description: Initialize the SysTick timer to run the call-back every
+ * given period using interrupts. Periods longer than the 24-bit counter
+ * are split in a hardware reload value and a software prescaler that
+ * runs the call-back every prescaler counter wraps. Periods shorter than
+ * SYSTICK_MIN_PERIOD_TICKS are rejected and the timer is left unchanged.
+ * ****************************************************************************/
+Std_ReturnType SysTick_InitPeriod(uint32 a_Period, SysTick_TimeUnitType a_Unit, uint64 *a_AchievedNanoSeconds)
+{
+    uint32 reloadTicks;
+    uint32 prescaler;
+    uint32 fractionTicks;
+    uint32 fractionUnits;
+    Critical_StateType state;
+
+    if(SysTick_ComputePeriod(a_Period, a_Unit, &reloadTicks, &prescaler, &fractionTicks, &fractionUnits) != E_OK)
+    {
+        return E_NOT_OK;
+    }
+
+    SysTick_SyncTimebase();                                                 // Disable the SysTick Timer and keep the elapsed time.
+
+    SYSTICK_RELOAD_REG  = reloadTicks - 1;                                  // Set the Reload value of one counter period.
+
+    SYSTICK_CURRENT_REG = 0;                                                // Clear the Current Register value.
+
+    g_reloadTicks       = reloadTicks;                                      // Remember the period length for the monotonic time.
+    g_activeTicks       = reloadTicks;
+    g_queuedTicks       = reloadTicks;
+    g_timebaseSequence++;
+    g_prescaler         = prescaler;
+    g_prescalerCount    = 0;
+    g_fractionTicks     = fractionTicks;
+    g_fractionUnits     = fractionUnits;
+    g_fractionCarry     = fractionTicks;                                    // Carried past the first period, which gets no extra tick.
+    g_queuedCarry       = 0;                                                // The grid starts with the first period.
+    g_activeCarry       = 0;
+    g_period            = a_Period;
+    g_periodUnit        = a_Unit;
+
+    (void) DWT_Init();                                                      // Times the re-phase window (and the call-backs).
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+    SysTick_ResetCpuLoad();                                                 // Windows are counted in clocks of the current core clock.
+#endif
+
+    state = Critical_Enter();
+    SYSTICK_CTRL_REG   |= 0x07;                                             // Enable SysTick timer & Interrupt & choose the clock source to be system clock.
+    if(fractionTicks != 0)
+    {
+        while(SYSTICK_CURRENT_REG == 0);                                    // The first period is loaded, queue the second one on the fractional grid.
+        SysTick_QueuePeriod();
+    }
+    Critical_Exit(state);
+
+    if(a_AchievedNanoSeconds != NULL_PTR)
+    {
+        if(fractionTicks != 0)
+        {
+            *a_AchievedNanoSeconds = (uint64) a_Period * (1000000000UL / fractionUnits);   // Exact on average with the fractional reload.
+        }
+        else
+        {
+            *a_AchievedNanoSeconds = SysTick_TicksToUnits((uint64) reloadTicks * prescaler, 1000000000UL);
+        }
+    }
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_StartBusyWait
+ * Sync/Async:
+ * Reentrancy:
+ * Parameters (in): a_TimeInMilliSeconds - Time in MilliSeconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Initialize the SysTick timer with the specified time
+ * in milliseconds using polling or busy-wait technique. The function
+ * should exit when the time is elapsed and stops the timer at the end.
+ * Times above the 24-bit counter range wait for several counter wraps.
+ * If the timer already runs in interrupt mode the function waits on
+ * SysTick_GetTicks64 instead and keeps the configuration (see also the
+ * non-blocking Deadline module). While the timer is paused
+ * (SysTick_Pause) it waits on the DWT cycle counter and leaves the
+ * frozen configuration untouched.
+ * ********************************************************************/
+void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
+{
+    uint32 reloadTicks;
+    uint32 prescaler;
+    uint64 deadline;
+
+    if( (g_reloadTicks != 0) && (SysTick_ReadCtrl() & SYSTICK_CTRL_ENABLE_MASK) )
+    {
+        /* The timer already runs (SysTick_Init), wait on its monotonic time and keep its configuration */
+        deadline = SysTick_GetTicks64() + ( ((uint64) a_TimeInMilliSeconds * SysTick_GetCoreClock()) / 1000 );
+        while(SysTick_GetTicks64() < deadline);
+        return;
+    }
+
+    if(g_paused)
+    {
+        /* The counter is frozen by SysTick_Pause, SysTick_Resume needs its configuration intact */
+        (void) DWT_Init();
+        DWT_DelayMs(a_TimeInMilliSeconds);
+        return;
+    }
+
+    if(SysTick_ComputePeriod(a_TimeInMilliSeconds, SYSTICK_UNIT_MILLI_SECONDS, &reloadTicks, &prescaler, NULL_PTR, NULL_PTR) != E_OK)
+    {
+        return;                                                                             // Nothing to wait for.
+    }
+
+    SysTick_SyncTimebase();                                                                 // Disable the SysTick Timer and keep the elapsed time.
+
+    SYSTICK_RELOAD_REG  = reloadTicks - 1;                                                  // Set the Reload value of one counter period.
+
+    SYSTICK_CURRENT_REG = 0;                                                                // Clear the Current Register value.
+
+    SYSTICK_CTRL_REG   |= 0x05;                                                             // Enable SysTick timer & choose the clock source to be system clock.
+
+    while(prescaler != 0)
+    {
+        while( !(SYSTICK_CTRL_REG  &  SYSTICK_CTRL_COUNT_FLAG_MASK) );                      // Wait until the COUNT flag = 1.
+        prescaler--;
+    }
+
+    SYSTICK_CTRL_REG    = 0;                                                                // Disable the SysTick Timer by Clear the ENABLE Bit.
+
+    SYSTICK_RELOAD_REG  = 0;                                                                // Set the Reload value 0.
+
+    SYSTICK_CURRENT_REG = 0;                                                                // Clear the Current Register value.
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_Handler
+ * Sync/Async:
+ * Reentrancy:
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Handler for SysTick interrupt use to call
+ * the call-back function.
+ * ********************************************************************/
+void SysTick_Handler(void)
+{
+#if (SYSTICK_LATENCY_STATS == TRUE) || (SYSTICK_OVERRUN_CHECK == TRUE)
+    uint32 current = SYSTICK_CURRENT_REG;   // Sample first, everything before it counts as latency.
+#endif
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+    uint32 entryCycles = SYSTICK_READ_CYCLES();
+#endif
+    Critical_StateType state;
+
+    /* Masked, so a higher priority ISR reading the time never sees the new wrap with the old cycle */
+    state = Critical_Enter();
+    if(g_wrapAccountedEarly)
+    {
+        g_wrapAccountedEarly = FALSE;   // A reader that preempted this handler accounted the wrap already.
+    }
+    else
+    {
+        SysTick_AccountWrap();
+    }
+    Critical_Exit(state);
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+    SysTick_RecordLatency(g_activeTicks, current);
+#endif
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+    if( (g_wrapTicks - g_loadWindowStart) >= g_loadWindowTicks )
+    {
+        SysTick_UpdateCpuLoad();        // Once per second.
+    }
+#endif
+
+    if(++g_prescalerCount < g_prescaler)
+    {
+        return;                         // Long period, more counter wraps to go.
+    }
+    g_prescalerCount = 0;
+
+    if(++g_tickCount == g_nextDueTick)
+    {
+        SysTick_Dispatch();             // Only when a subscriber is due, a single compare otherwise.
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+        SysTick_RecordCallBackTime(SYSTICK_READ_CYCLES() - entryCycles);
+#endif
+    }
+
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
+    if(NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK)
+    {
+        SysTick_RecordOverrun(g_activeTicks, current, SYSTICK_READ_CYCLES() - entryCycles);
+    }
+#endif
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_SetCallBack
+ * Sync/Async:
+ * Reentrancy:
+ * Parameters (in): Ptr2Func - Pointer to function
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to setup the SysTick Timer call back
+ * to be executed in the SysTick Handler. The call-back takes a
+ * subscriber entry with divider 1 and replaces the previous one.
+ * ********************************************************************/
+void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
+{
+    if(g_callBackPtr != NULL_PTR)
+    {
+        (void) SysTick_Unsubscribe( (void (*)(void)) g_callBackPtr );
+    }
+
+    g_callBackPtr = Ptr2Func;           // Make pointer have address of given function.
+
+    if(Ptr2Func != NULL_PTR)
+    {
+        (void) SysTick_Subscribe( (void (*)(void)) Ptr2Func, 1, 0 );
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_Subscribe
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_CallBack - Function to execute in the SysTick handler
+ *                  a_Divider - Run the call-back every a_Divider ticks (1 = every tick)
+ *                  a_Phase - Tick count modulo a_Divider at which the call-back runs (0 .. a_Divider - 1)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the table is full, the call-back is already subscribed or an argument is invalid
+ * Description: Function to add a call-back to the SysTick subscriber
+ * table. Subscribers with the same divider and different phases never
+ * run in the same tick, which spreads their load.
+ * ********************************************************************/
+Std_ReturnType SysTick_Subscribe(void (*a_CallBack)(void), uint32 a_Divider, uint32 a_Phase)
+{
+    SysTick_SubscriberType subscriber;
+    Std_ReturnType status = E_OK;
+    Critical_StateType state;
+    uint32 index;
+    uint32 offset;
+
+    if( (a_CallBack == NULL_PTR) || (a_Divider == 0) || (a_Phase >= a_Divider) )
+    {
+        return E_NOT_OK;
+    }
+
+    state = Critical_Enter();
+
+    for(index = 0; index < g_subscribersNumber; index++)
+    {
+        if(g_subscribers[index].CallBack == a_CallBack)
+        {
+            status = E_NOT_OK;                                              // Already subscribed.
+        }
+    }
+
+    if( (status == E_OK) && (g_subscribersNumber < SYSTICK_MAX_SUBSCRIBERS) )
+    {
+        offset = (a_Phase + a_Divider - (g_tickCount % a_Divider)) % a_Divider;     // Ticks to the next tick count matching the phase.
+
+        subscriber.CallBack    = a_CallBack;
+        subscriber.Divider     = a_Divider;
+        subscriber.NextDueTick = g_tickCount + ( (offset != 0) ? offset : a_Divider );
+        SysTick_InsertSubscriber(&subscriber);
+    }
+    else
+    {
+        status = E_NOT_OK;
+    }
+
+    Critical_Exit(state);
+
+    return status;
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_Unsubscribe
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_CallBack - Function given to SysTick_Subscribe
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the call-back is not subscribed
+ * Description: Function to remove a call-back from the SysTick
+ * subscriber table.
+ * ********************************************************************/
+Std_ReturnType SysTick_Unsubscribe(void (*a_CallBack)(void))
+{
+    Std_ReturnType status = E_NOT_OK;
+    Critical_StateType state = Critical_Enter();
+    uint32 index;
+
+    for(index = 0; index < g_subscribersNumber; index++)
+    {
+        if(g_subscribers[index].CallBack == a_CallBack)
+        {
+            SysTick_RemoveSubscriber(index);
+            status = E_OK;
+            break;
+        }
+    }
+
+    Critical_Exit(state);
+
+    return status;
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_Stop
+ * Sync/Async:
+ * Reentrancy:
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to stop (pause) the SysTick Timer.
+ * ********************************************************************/
+void SysTick_Stop(void)
+{
+    SYSTICK_CTRL_REG   = SysTick_ReadCtrl() & ~SYSTICK_CTRL_ENABLE_MASK;   // Stop the timer.
+}
+
 
-/*****************************************************************************
- * Service Name: SysTick_Init
+/*********************************************************************
+ * Service Name: SysTick_Start
  * Sync/Async:
  * Reentrancy:
- * Parameters (in): a_TimeInMilliSeconds - Time in MilliSeconds
+ * Parameters (in): None
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Initialize the SysTick timer with the specified time
- * in milliseconds using interrupts. This function is used to setup the
- * timer to generate periodic interrupts every specified time in milliseconds.
- * ****************************************************************************/
-void SysTick_Init(uint16 a_TimeInMilliSeconds)
+ * Description: Function to start/resume the SysTick Timer.
+ * ********************************************************************/
+void SysTick_Start(void)
 {
-    SYSTICK_CTRL_REG    = 0;                                                                // Disable the SysTick Timer by Clear the ENABLE Bit.
+    SYSTICK_CTRL_REG   = SysTick_ReadCtrl() | SYSTICK_CTRL_ENABLE_MASK;    // Start timer.
+}
 
-    SYSTICK_RELOAD_REG  = ( (uint32) a_TimeInMilliSeconds * SYSTICK_RELOAD_VALUE ) - 1;     // Set the Reload value to count Seconds.
 
-    SYSTICK_CURRENT_REG = 0;                                                                // Clear the Current Register value.
+/*********************************************************************
+ * Service Name: SysTick_Pause
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Mode - SYSTICK_PAUSE_EXCLUDE_TIME to shift the schedule and the monotonic
+ *                           time by the pause, SYSTICK_PAUSE_INCLUDE_TIME to keep both locked to wall time
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pause the SysTick Timer. The counter is frozen
+ * and keeps the remaining count of the current period, the monotonic
+ * time holds still until SysTick_Resume. Including the paused time uses
+ * the hibernation RTC, which this function starts, so the pause may be
+ * of any length and span sleep; the DWT cycle counter refines it to the
+ * clock. Only while the RTC crystal starts (the first such pause, unless
+ * SysTick_Calibrate ran) the DWT count alone is used, which requires a
+ * pause shorter than 2^32 core clocks without sleep.
+ * ********************************************************************/
+void SysTick_Pause(SysTick_PauseModeType a_Mode)
+{
+    Critical_StateType state = Critical_Enter();
+
+    if( (g_reloadTicks != 0) && !g_paused && (SysTick_ReadCtrl() & SYSTICK_CTRL_ENABLE_MASK) )
+    {
+        if(a_Mode == SYSTICK_PAUSE_INCLUDE_TIME)
+        {
+            (void) DWT_Init();                                              // Make sure the pause can be measured.
+            g_pauseRtcValid = SysTick_StartRtc();
+        }
 
-    SYSTICK_CTRL_REG   |= 0x07;                                                             // Enable SysTick timer & Interrupt & choose the clock source to be system clock.
+        SYSTICK_CTRL_REG = SysTick_ReadCtrl() & ~SYSTICK_CTRL_ENABLE_MASK;  // Freeze the counter, a wrap that is already pending still runs the handler.
+        g_pauseCycles = DWT_GetCycles();
+        g_pauseRtc    = (g_pauseRtcValid == TRUE) ? SysTick_ReadRtc() : 0;
+        g_pauseMode   = a_Mode;
+        g_paused      = TRUE;
+    }
+
+    Critical_Exit(state);
 }
 
 
 /*********************************************************************
- * Service Name: SysTick_StartBusyWait
+ * Service Name: SysTick_Resume
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to resume the SysTick Timer after SysTick_Pause.
+ * Excluding the paused time, the counter continues with the remaining
+ * count it was frozen at. Including it, the paused time is added to the
+ * monotonic time, the periods missed during the pause are replayed to
+ * the subscribers and the counter is restarted on the original tick grid.
+ * ********************************************************************/
+void SysTick_Resume(void)
+{
+    Critical_StateType state = Critical_Enter();
+
+    if(g_paused)
+    {
+        g_paused = FALSE;
+
+        if(g_pauseMode == SYSTICK_PAUSE_INCLUDE_TIME)
+        {
+            SysTick_Rephase(SysTick_PausedTicks());
+        }
+        else
+        {
+            SYSTICK_CTRL_REG = SysTick_ReadCtrl() | SYSTICK_CTRL_ENABLE_MASK;   // Continue from the frozen count.
+        }
+    }
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_DeInit
  * Sync/Async:
  * Reentrancy:
- * Parameters (in): a_TimeInMilliSeconds - Time in MilliSeconds
+ * Parameters (in): None
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Initialize the SysTick timer with the specified time
- * in milliseconds using polling or busy-wait technique. The function
- * should exit when the time is elapsed and stops the timer at the end.
+ * Description: Function to Deinitialize the SysTick Timer.
  * ********************************************************************/
-void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds)
+void SysTick_DeInit(void)
 {
-    SYSTICK_CTRL_REG    = 0;                                                                // Disable the SysTick Timer by Clear the ENABLE Bit.
+    SysTick_SyncTimebase();         // Disable the SysTick Timer and keep the elapsed time.
 
-    SYSTICK_RELOAD_REG  = ( (uint32) a_TimeInMilliSeconds * SYSTICK_RELOAD_VALUE ) - 1;     // Set the Reload value to count Seconds.
+    SYSTICK_RELOAD_REG  = 0;        // Set the Reload value 0.
 
-    SYSTICK_CURRENT_REG = 0;                                                                // Clear the Current Register value.
+    SYSTICK_CURRENT_REG = 0;        // Clear the Current Register value.
 
-    SYSTICK_CTRL_REG   |= 0x05;                                                             // Enable SysTick timer & choose the clock source to be system clock.
+    g_callBackPtr = NULL_PTR;
 
-    while( !(SYSTICK_CTRL_REG  &  SYSTICK_CTRL_COUNT_FLAG_MASK) );                          // Wait until the COUNT flag = 1.
+    g_subscribersNumber = 0;        // Drop all subscribers.
+    g_nextDueTick       = g_tickCount;
+}
 
-    SYSTICK_CTRL_REG    = 0;                                                                // Disable the SysTick Timer by Clear the ENABLE Bit.
 
-    SYSTICK_RELOAD_REG  = 0;                                                                // Set the Reload value 0.
+/*********************************************************************
+ * Service Name: SysTick_GetTicks64
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint64 - SysTick clock ticks elapsed since the first SysTick_Init
+ * Description: Function to read the 64-bit monotonic SysTick time with
+ * single clock tick resolution. The wrap time kept by SysTick_Handler is
+ * combined with SYSTICK_CURRENT_REG using a retry loop on a sequence count
+ * the timebase updates bump, so it can be called from the main loop or any
+ * ISR without masking interrupts. An ISR that preempts SysTick_Handler
+ * before it accounted its wrap (COUNTFLAG still set) accounts the wrap
+ * itself in a short masked section, so the time never steps back
+ * whatever the caller priority.
+ * ********************************************************************/
+uint64 SysTick_GetTicks64(void)
+{
+    uint64 wrapTicks;
+    uint32 activeTicks;
+    uint32 queuedTicks;
+    uint32 current;
+    uint32 pending;
+    uint32 sequence;
 
-    SYSTICK_CURRENT_REG = 0;                                                                // Clear the Current Register value.
+    if(NVIC_SYSTEM_SYSHNDCTRL & SYSTICK_SYSHNDCTRL_TICKACT_MASK)
+    {
+        SysTick_CatchUpWrap();                                              // Only an ISR can find the handler active, the main loop never masks.
+    }
+
+    do
+    {
+        sequence    = g_timebaseSequence;
+        wrapTicks   = g_wrapTicks;
+        activeTicks = g_activeTicks;
+        queuedTicks = g_queuedTicks;
+        current     = SYSTICK_CURRENT_REG;
+        pending     = NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK;
+    } while(sequence != g_timebaseSequence);                                // Retry if a timebase update ran meanwhile.
+
+    if(activeTicks == 0)
+    {
+        return wrapTicks;                                                   // Timer is not configured, the time holds still.
+    }
+
+    if(pending)
+    {
+        /* The counter wrapped but the handler did not run yet (caller masks interrupts or
+         * runs at a higher priority), re-read the counter so it belongs to the new cycle. */
+        current     = SYSTICK_CURRENT_REG;
+        wrapTicks  += activeTicks;
+        activeTicks = queuedTicks;
+    }
+
+    if(current != 0)
+    {
+        wrapTicks += activeTicks - current;                                 // Counter reaching 0 is the cycle boundary itself.
+    }
+
+    return wrapTicks;
 }
 
 
 /*********************************************************************
- * Service Name: SysTick_Handler
- * Sync/Async:
- * Reentrancy:
+ * Service Name: SysTick_GetMicros
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
  * Parameters (in): None
  * Parameters (inout): None
  * Parameters (out): None
- * Return value: None
- * Description: Handler for SysTick interrupt use to call
- * the call-back function.
+ * Return value: uint64 - Microseconds elapsed since the first SysTick_Init
+ * Description: Function to read the monotonic SysTick time in microseconds.
  * ********************************************************************/
-void SysTick_Handler(void)
+uint64 SysTick_GetMicros(void)
 {
-    if(g_callBackPtr != NULL_PTR)
+    return SysTick_TicksToUnits(SysTick_GetTicks64(), 1000000UL);
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_GetCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Core (and SysTick) clock frequency in Hz
+ * Description: Function to get the core clock frequency used for all
+ * period conversions. It is derived once from SYSCTL_RCC_REG,
+ * SYSCTL_RCC2_REG and the PLL registers and cached, call
+ * SysTick_UpdateCoreClock after changing the clock tree. After
+ * SysTick_Calibrate it is the measured frequency.
+ * ********************************************************************/
+uint32 SysTick_GetCoreClock(void)
+{
+    if(g_coreClockHz == 0)
     {
-        (*g_callBackPtr)();             // Call the function that the pointer had address.
+        g_nominalClockHz = SysTick_ReadCoreClock();
+        g_coreClockHz    = g_nominalClockHz;
     }
+
+    return g_coreClockHz;
 }
 
 
 /*********************************************************************
- * Service Name: SysTick_SetCallBack
- * Sync/Async:
- * Reentrancy:
- * Parameters (in): Ptr2Func - Pointer to function
+ * Service Name: SysTick_UpdateCoreClock
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the running period can not be generated at the new clock
+ * Description: Function to re-derive the core clock right after the
+ * application changed the clock tree (e.g. switched to the 80 MHz PLL).
+ * A running timer is reprogrammed with the period it was started with,
+ * the monotonic time is rescaled to the new tick rate and the clock
+ * change call-back runs so users can rescale their own tick values.
+ * ********************************************************************/
+Std_ReturnType SysTick_UpdateCoreClock(void)
+{
+    uint32 oldClockHz = SysTick_GetCoreClock();
+    uint32 newClockHz = SysTick_ReadCoreClock();
+
+    if(newClockHz == g_nominalClockHz)
+    {
+        return E_OK;                                                        // Same clock tree, a calibration stays valid.
+    }
+
+    g_nominalClockHz = newClockHz;
+
+    return SysTick_ChangeCoreClock(oldClockHz, newClockHz);
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_Calibrate
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_WindowSeconds - Measurement window (1 .. SYSTICK_CALIBRATION_MAX_SECONDS)
+ * Parameters (inout): None
+ * Parameters (out): a_ErrorPpm - Measured core clock deviation from the nominal clock in ppm, may be NULL_PTR
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the timer does not run or the reference is missing
+ * Description: Function to measure the real SysTick (core) clock against
+ * the 32.768 kHz crystal of the hibernation RTC, which it starts if
+ * needed. It busy waits for the window with the interrupts enabled and
+ * the timer running (SysTick_Init). The measured frequency replaces the
+ * nominal one, so periods, the monotonic time and the clock change
+ * call-back all use it, and periods that are not a whole number of
+ * clocks are generated with a fractional reload. SysTick_UpdateCoreClock
+ * keeps the calibration until the clock tree changes.
+ * ********************************************************************/
+Std_ReturnType SysTick_Calibrate(uint32 a_WindowSeconds, sint32 *a_ErrorPpm)
+{
+    uint32 clockHz   = SysTick_GetCoreClock();                              // Derives the nominal clock on first use.
+    uint32 nominalHz = g_nominalClockHz;
+    uint64 timeout   = (uint64) clockHz * SYSTICK_CALIBRATION_START_SECONDS;
+    uint32 rtcStart;
+    uint32 rtcEnd;
+    uint64 ticksStart;
+    uint64 ticksEnd;
+    uint64 measuredHz;
+    uint64 deviation;
+
+    if( (a_WindowSeconds == 0) || (a_WindowSeconds > SYSTICK_CALIBRATION_MAX_SECONDS) || (g_reloadTicks == 0) || (g_paused == TRUE) )
+    {
+        return E_NOT_OK;
+    }
+
+    if(SysTick_StartRtc() == FALSE)
+    {
+        /* The crystal was just started, skip its first edges until it settled */
+        rtcStart = SysTick_ReadRtc();
+        rtcEnd   = rtcStart;
+        while( (rtcEnd - rtcStart) < (SYSTICK_CALIBRATION_SETTLE_SECONDS << HIB_RTCSS_BITS) )
+        {
+            if(SysTick_WaitRtcEdge(rtcEnd, &rtcEnd, &ticksEnd, timeout) != E_OK)
+            {
+                return E_NOT_OK;                                            // The crystal does not run.
+            }
+        }
+    }
+
+    /* Time the window between two RTC edges, the polling error is a few clocks at each end */
+    if(SysTick_WaitRtcEdge(SysTick_ReadRtc(), &rtcStart, &ticksStart, timeout) != E_OK)
+    {
+        return E_NOT_OK;                                                    // The crystal does not run.
+    }
+
+    rtcEnd = rtcStart;
+    while( (rtcEnd - rtcStart) < (a_WindowSeconds << HIB_RTCSS_BITS) )
+    {
+        if(SysTick_WaitRtcEdge(rtcEnd, &rtcEnd, &ticksEnd, timeout) != E_OK)
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    measuredHz = ( (ticksEnd - ticksStart) * SYSTICK_HIB_OSC_HZ ) / (rtcEnd - rtcStart);     // The timebase counts real clocks.
+
+    deviation = (measuredHz > nominalHz) ? (measuredHz - nominalHz) : (nominalHz - measuredHz);
+    deviation = (deviation * 1000000UL) / nominalHz;
+
+    if(deviation > SYSTICK_CALIBRATION_MAX_PPM)
+    {
+        return E_NOT_OK;
+    }
+
+    if(a_ErrorPpm != NULL_PTR)
+    {
+        *a_ErrorPpm = (measuredHz >= nominalHz) ? (sint32) deviation : -(sint32) deviation;
+    }
+
+    if( (uint32) measuredHz == clockHz )
+    {
+        return E_OK;
+    }
+
+    return SysTick_ChangeCoreClock(clockHz, (uint32) measuredHz);
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_SetClockChangeCallBack
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Ptr2Func - Function called with the old and new clock in Hz
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to setup the SysTick Timer call back
- * to be executed in the SysTick Handler.
+ * Description: Function to setup the call back executed by
+ * SysTick_UpdateCoreClock when the core clock frequency changed.
  * ********************************************************************/
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void))
+void SysTick_SetClockChangeCallBack(void (*Ptr2Func) (uint32 a_OldClockHz, uint32 a_NewClockHz))
 {
-    g_callBackPtr = Ptr2Func;           // Make pointer have address of given function.
+    g_clockChangeCallBackPtr = Ptr2Func;
 }
 
 
 /*********************************************************************
- * Service Name: SysTick_Stop
- * Sync/Async:
- * Reentrancy:
- * Parameters (in): None
+ * Service Name: SysTick_EnterTicklessIdle
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_GetIdleTicks - Function returning the number of ticks until the
+ *                                   next pending deadline (e.g. SwTimer_GetTicksToNextExpiry)
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to stop (pause) the SysTick Timer.
+ * Description: Function to put the core to sleep (WFI) until the next
+ * deadline without waking on every tick. The long sleep cycle is queued
+ * in SYSTICK_RELOAD_REG so it starts exactly at the next tick boundary
+ * and the nominal period is queued again right after it, the counter
+ * is never stopped on this path and the tick grid does not drift. A
+ * fractional period (see SysTick_InitPeriod) lays the sleep out on the
+ * same grid: every skipped period adds its share of the fraction. When
+ * another interrupt moves the deadline earlier, the long cycle is cut
+ * using SYSTICK_CURRENT_REG. The ticks skipped during the sleep are
+ * replayed through the subscriber table before returning, subscribers
+ * that a_GetIdleTicks does not account for run late, at wake-up. Prescaled periods
+ * (see SysTick_InitPeriod) wake on every counter wrap as with plain WFI.
  * ********************************************************************/
-void SysTick_Stop(void)
+void SysTick_EnterTicklessIdle(uint32 (*a_GetIdleTicks)(void))
 {
-    SYSTICK_CTRL_REG  &= ~ SYSTICK_CTRL_ENABLE_MASK;               // Stop the timer.
+    Critical_StateType state = Critical_Enter();                            // WFI still wakes on a pending interrupt while PRIMASK is set.
+    uint32 reload = g_reloadTicks;
+    uint32 longestPeriod = reload + ( (g_fractionTicks != 0) ? 1 : 0 );     // A period with a fraction carry is one tick longer.
+    uint32 queuedTicks   = g_queuedTicks;
+    uint32 fractionCarry = g_fractionCarry;
+    uint32 idleTicks;
+    uint32 sleepTicks;
+
+    idleTicks = (a_GetIdleTicks != NULL_PTR) ? a_GetIdleTicks() : 0;
+
+    if( (reload == 0) || (longestPeriod > (SYSTICK_MAX_CYCLE_TICKS / 2)) || (g_prescaler != 1) || ((g_activeTicks - reload) > 1) || (idleTicks < SYSTICK_TICKLESS_MIN_IDLE_TICKS) ||
+        !(SysTick_ReadCtrl() & SYSTICK_CTRL_ENABLE_MASK) || (NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK) )
+    {
+        /* Nothing to gain, sleep until the next interrupt as usual */
+        SysTick_Sleep();
+        Critical_Exit(state);
+        return;
+    }
+
+    if( (idleTicks - 1) > (SYSTICK_MAX_CYCLE_TICKS / longestPeriod) )
+    {
+        idleTicks = (SYSTICK_MAX_CYCLE_TICKS / longestPeriod) + 1;          // Longest sleep the 24-bit counter allows.
+    }
+
+    /* The sleep replaces the queued period and the idleTicks - 2 after it, each with its share of the fraction */
+    sleepTicks = queuedTicks + ( (idleTicks - 2) * reload ) + SysTick_AdvanceFraction(idleTicks - 2);
+
+    /* Queue the long cycle, the counter loads it at the next tick boundary by itself */
+    SYSTICK_RELOAD_REG = sleepTicks - 1;
+    g_queuedTicks      = sleepTicks;
+
+    while(g_activeTicks != sleepTicks)
+    {
+        SysTick_Sleep();
+        Critical_Exit(state);                                               // Run the handler(s) that woke the core.
+        state = Critical_Enter();
+
+        if( (g_activeTicks != sleepTicks) && (a_GetIdleTicks() < idleTicks) )
+        {
+            /* Another interrupt needs an earlier deadline, queue the nominal period again */
+            SYSTICK_RELOAD_REG = queuedTicks - 1;
+            g_queuedTicks      = queuedTicks;
+            g_fractionCarry    = fractionCarry;
+
+            if( (NVIC_SYSTEM_INTCTRL & SYSTICK_INTCTRL_PENDSTSET_MASK) && (SYSTICK_CURRENT_REG > reload) )
+            {
+                g_queuedTicks = sleepTicks;                                 // Too late, the counter loaded the long cycle meanwhile.
+                Critical_Exit(state);                                       // Let the handler account the boundary.
+                state = Critical_Enter();
+                SysTick_Rephase(0);
+            }
+            Critical_Exit(state);
+            return;
+        }
+    }
+
+    /* The long cycle is running: queue the nominal period so ticking resumes right after it */
+    SysTick_QueuePeriod();
+
+    while(g_activeTicks == sleepTicks)
+    {
+        if(a_GetIdleTicks() < (idleTicks - 1))
+        {
+            SysTick_Rephase(0);                                              // A deadline moved into the sleep, tick normally again.
+            break;
+        }
+
+        SysTick_Sleep();
+        Critical_Exit(state);
+        state = Critical_Enter();
+
+        if(g_activeTicks != sleepTicks)
+        {
+            SysTick_ReplayTicks(idleTicks - 2);                             // The handler already ran the last tick of the sleep.
+        }
+    }
+
+    Critical_Exit(state);
 }
 
 
 /*********************************************************************
- * Service Name: SysTick_Start
- * Sync/Async:
- * Reentrancy:
+ * Service Name: SysTick_Idle
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
  * Parameters (in): None
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to start/resume the SysTick Timer.
+ * Description: Function to sleep (WFI) until the next interrupt, called
+ * from the idle loop instead of a plain WFI. The sleep runs with
+ * interrupts masked and is accounted as idle time for the CPU load
+ * before the handler that woke the core runs. It may be called with
+ * interrupts already masked, after checking there is no work left.
  * ********************************************************************/
-void SysTick_Start(void)
+void SysTick_Idle(void)
+{
+    Critical_StateType state = Critical_Enter();                            // WFI still wakes on a pending interrupt while PRIMASK is set.
+
+    SysTick_Sleep();
+
+    Critical_Exit(state);
+}
+
+
+#if (SYSTICK_CPU_LOAD == TRUE)
+/*********************************************************************
+ * Service Name: SysTick_GetCpuLoad
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Window - Averaging window
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Busy time in per mille (0 .. 1000) of the window
+ * Description: Function to read the CPU load. Time outside SysTick_Idle
+ * and SysTick_EnterTicklessIdle counts as busy. SysTick_Handler publishes
+ * the figures once per second, so the read is a single word load. A
+ * tickless sleep longer than a second counts as one window.
+ * ********************************************************************/
+uint32 SysTick_GetCpuLoad(SysTick_LoadWindowType a_Window)
 {
-    SYSTICK_CTRL_REG  |=  SYSTICK_CTRL_ENABLE_MASK;               // Start timer.
+    return (a_Window < SYSTICK_LOAD_WINDOWS) ? g_cpuLoad[a_Window] : 0;
 }
+#endif
 
 
+#if (SYSTICK_OVERRUN_CHECK == TRUE)
 /*********************************************************************
- * Service Name: SysTick_DeInit
- * Sync/Async:
- * Reentrancy:
+ * Service Name: SysTick_GetOverrunStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the overrun statistics
+ * Return value: None
+ * Description: Function to read a consistent copy of the late and lost
+ * tick counters and the worst call-back duration. Lost ticks are
+ * estimated from the DWT cycle counter, which SysTick_InitPeriod starts.
+ * ********************************************************************/
+void SysTick_GetOverrunStats(SysTick_OverrunStatsType *a_Stats)
+{
+    Critical_StateType state = Critical_Enter();                            // The handler updates the statistics.
+
+    *a_Stats = g_overrunStats;
+
+    Critical_Exit(state);
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_ResetOverrunStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
  * Parameters (in): None
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to Deinitialize the SysTick Timer.
+ * Description: Function to clear the overrun statistics.
  * ********************************************************************/
-void SysTick_DeInit(void)
+void SysTick_ResetOverrunStats(void)
 {
-    SYSTICK_CTRL_REG    = 0;        // Disable the SysTick Timer by Clear the ENABLE Bit.
+    Critical_StateType state = Critical_Enter();
 
-    SYSTICK_RELOAD_REG  = 0;        // Set the Reload value 0.
+    g_overrunStats.LateTicks           = 0;
+    g_overrunStats.LostTicks           = 0;
+    g_overrunStats.WorstCallBackCycles = 0;
 
-    SYSTICK_CURRENT_REG = 0;        // Clear the Current Register value.
+    Critical_Exit(state);
+}
 
-    g_callBackPtr = NULL_PTR;
+
+/*********************************************************************
+ * Service Name: SysTick_SetOverrunHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): a_Hook - Function called with the call-back run time in clocks, NULL_PTR to remove it
+ *                  a_BudgetCycles - Allowed call-back run time per tick in clocks, 0 for one tick period
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to setup the hook executed in the SysTick
+ * handler when the call-backs due at a tick ran longer than the budget.
+ * ********************************************************************/
+void SysTick_SetOverrunHook(void (*a_Hook)(uint32 a_CallBackCycles), uint32 a_BudgetCycles)
+{
+    Critical_StateType state = Critical_Enter();
+
+    g_overrunHookPtr = a_Hook;
+    g_overrunBudget  = a_BudgetCycles;
+
+    Critical_Exit(state);
+}
+#endif
+
+
+#if (SYSTICK_LATENCY_STATS == TRUE)
+/*********************************************************************
+ * Service Name: SysTick_GetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): a_Stats - Copy of the handler entry latency statistics
+ * Return value: None
+ * Description: Function to read a consistent copy of the latency
+ * histogram, min, max and mean (e.g. for a debug dump).
+ * ********************************************************************/
+void SysTick_GetLatencyStats(SysTick_LatencyStatsType *a_Stats)
+{
+    Critical_StateType state = Critical_Enter();                            // The handler updates the statistics.
+
+    *a_Stats = g_latencyStats;
+
+    Critical_Exit(state);
+
+    a_Stats->Mean = (a_Stats->Samples != 0) ? (uint32) (a_Stats->Sum / a_Stats->Samples) : 0;
+}
+
+
+/*********************************************************************
+ * Service Name: SysTick_ResetLatencyStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the latency statistics.
+ * ********************************************************************/
+void SysTick_ResetLatencyStats(void)
+{
+    Critical_StateType state = Critical_Enter();
+    uint32 index;
+
+    g_latencyStats.Samples = 0;
+    g_latencyStats.Min     = 0xFFFFFFFFUL;
+    g_latencyStats.Max     = 0;
+    g_latencyStats.Sum     = 0;
+    for(index = 0; index < SYSTICK_LATENCY_BUCKETS; index++)
+    {
+        g_latencyStats.Histogram[index] = 0;
+    }
+
+    Critical_Exit(state);
 }
+#endif
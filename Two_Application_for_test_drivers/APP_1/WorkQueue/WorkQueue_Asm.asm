@@ -0,0 +1,64 @@
+;******************************************************************************
+;
+; Module: WorkQueue
+;
+; File Name: WorkQueue_Asm.asm
+;
+; Description: Lock-free slot claim of the work queue, written in assembly
+;              because the compiler has no intrinsic for LDREX/STREX
+;
+; Author: Bassam Ashraf
+;
+;******************************************************************************
+
+        .thumb
+        .text
+        .align  2
+
+        .global WorkQueue_ClaimSlot
+        .global WorkQueue_AtomicIncrement
+
+;******************************************************************************
+; uint32 WorkQueue_ClaimSlot(volatile uint32 *Head, volatile uint32 *Tail, uint32 Size)
+; r0 = &g_head, r1 = &g_tail, r2 = ring size (power of 2).
+; Moves the head by one and returns the ring index of the claimed slot, or
+; Size when the ring is full. An exception between LDREX and STREX clears
+; the exclusive monitor, so a producer it preempted retries the claim.
+;******************************************************************************
+WorkQueue_ClaimSlot: .asmfunc
+        PUSH    {r4}
+WorkQueue_ClaimRetry:
+        LDREX   r3, [r0]                    ; head
+        LDR     r12, [r1]                   ; tail
+        SUB     r12, r3, r12
+        CMP     r12, r2
+        BHS     WorkQueue_ClaimFull
+        ADD     r12, r3, #1
+        STREX   r4, r12, [r0]
+        CMP     r4, #0
+        BNE     WorkQueue_ClaimRetry        ; Another producer moved the head meanwhile
+        SUB     r2, r2, #1
+        AND     r0, r3, r2                  ; head & WORKQUEUE_MASK
+        POP     {r4}
+        BX      lr
+WorkQueue_ClaimFull:
+        CLREX
+        MOV     r0, r2
+        POP     {r4}
+        BX      lr
+        .endasmfunc
+
+;******************************************************************************
+; void WorkQueue_AtomicIncrement(volatile uint32 *Counter)
+; r0 = counter incremented by one, safe against preempting producers.
+;******************************************************************************
+WorkQueue_AtomicIncrement: .asmfunc
+        LDREX   r1, [r0]
+        ADD     r1, r1, #1
+        STREX   r2, r1, [r0]
+        CMP     r2, #0
+        BNE     WorkQueue_AtomicIncrement
+        BX      lr
+        .endasmfunc
+
+        .end
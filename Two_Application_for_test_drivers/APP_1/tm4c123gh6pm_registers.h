@@ -191,6 +191,22 @@ NVIC Registers
 #define NVIC_DIS2_REG             (*((volatile uint32 *)0xE000E188))
 #define NVIC_DIS3_REG             (*((volatile uint32 *)0xE000E18C))
 #define NVIC_DIS4_REG             (*((volatile uint32 *)0xE000E190))
+#define NVIC_PEND0_REG            (*((volatile uint32 *)0xE000E200))
+#define NVIC_PEND1_REG            (*((volatile uint32 *)0xE000E204))
+#define NVIC_PEND2_REG            (*((volatile uint32 *)0xE000E208))
+#define NVIC_PEND3_REG            (*((volatile uint32 *)0xE000E20C))
+#define NVIC_PEND4_REG            (*((volatile uint32 *)0xE000E210))
+#define NVIC_UNPEND0_REG          (*((volatile uint32 *)0xE000E280))
+#define NVIC_UNPEND1_REG          (*((volatile uint32 *)0xE000E284))
+#define NVIC_UNPEND2_REG          (*((volatile uint32 *)0xE000E288))
+#define NVIC_UNPEND3_REG          (*((volatile uint32 *)0xE000E28C))
+#define NVIC_UNPEND4_REG          (*((volatile uint32 *)0xE000E290))
+#define NVIC_ACTIVE0_REG          (*((volatile uint32 *)0xE000E300))
+#define NVIC_ACTIVE1_REG          (*((volatile uint32 *)0xE000E304))
+#define NVIC_ACTIVE2_REG          (*((volatile uint32 *)0xE000E308))
+#define NVIC_ACTIVE3_REG          (*((volatile uint32 *)0xE000E30C))
+#define NVIC_ACTIVE4_REG          (*((volatile uint32 *)0xE000E310))
+#define NVIC_SW_TRIG_REG          (*((volatile uint32 *)0xE000EF00))
 
 /*****************************************************************************
 System Control Block Registers
@@ -199,8 +215,15 @@ System Control Block Registers
 #define NVIC_SYSTEM_PRI2_REG      (*((volatile uint32 *)0xE000ED1C))
 #define NVIC_SYSTEM_PRI3_REG      (*((volatile uint32 *)0xE000ED20))
 #define NVIC_SYSTEM_SYSHNDCTRL    (*((volatile uint32 *)0xE000ED24))
+#define NVIC_SYSTEM_FAULTSTAT     (*((volatile uint32 *)0xE000ED28))
+#define NVIC_SYSTEM_HFAULTSTAT    (*((volatile uint32 *)0xE000ED2C))
+#define NVIC_SYSTEM_MMADDR        (*((volatile uint32 *)0xE000ED34))
+#define NVIC_SYSTEM_FAULTADDR     (*((volatile uint32 *)0xE000ED38))
 #define NVIC_SYSTEM_INTCTRL       (*((volatile uint32 *)0xE000ED04))
+#define NVIC_SYSTEM_VTABLE        (*((volatile uint32 *)0xE000ED08))
+#define NVIC_SYSTEM_APINT         (*((volatile uint32 *)0xE000ED0C))
 #define NVIC_SYSTEM_CFGCTRL       (*((volatile uint32 *)0xE000ED14))
+#define NVIC_SYSTEM_PRI_BYTE(n)   (*((volatile uint8 *)(0xE000ED14 + (n))))   /* Priority byte of system exception number n (4 .. 15) */
 
 /*****************************************************************************
 MPU Registers
@@ -217,6 +240,13 @@ MPU Registers
 #define MPU_BASE3_REG             (*((volatile uint32 *)0xE000EDB4))
 #define MPU_ATTR3_REG             (*((volatile uint32 *)0xE000EDB8))
 
+/*****************************************************************************
+Debug and Trace Registers
+*****************************************************************************/
+#define DEBUG_DEMCR_REG           (*((volatile uint32 *)0xE000EDFC))
+#define DWT_CTRL_REG              (*((volatile uint32 *)0xE0001000))
+#define DWT_CYCCNT_REG            (*((volatile uint32 *)0xE0001004))
+
 /*****************************************************************************
 System Control Registers
 *****************************************************************************/
@@ -408,6 +438,21 @@ Micro Direct Memory Access Registers (UDMA)
 #define UDMA_CHMAP2_REG           (*((volatile uint32 *)0x400FF518))
 #define UDMA_CHMAP3_REG           (*((volatile uint32 *)0x400FF51C))
 
+/*****************************************************************************
+Hibernation Module Registers
+*****************************************************************************/
+#define HIB_RTCC_REG              (*((volatile uint32 *)0x400FC000))
+#define HIB_RTCM0_REG             (*((volatile uint32 *)0x400FC004))
+#define HIB_RTCLD_REG             (*((volatile uint32 *)0x400FC00C))
+#define HIB_CTL_REG               (*((volatile uint32 *)0x400FC010))
+#define HIB_IM_REG                (*((volatile uint32 *)0x400FC014))
+#define HIB_RIS_REG               (*((volatile uint32 *)0x400FC018))
+#define HIB_MIS_REG               (*((volatile uint32 *)0x400FC01C))
+#define HIB_IC_REG                (*((volatile uint32 *)0x400FC020))
+#define HIB_RTCT_REG              (*((volatile uint32 *)0x400FC024))
+#define HIB_RTCSS_REG             (*((volatile uint32 *)0x400FC028))
+#define HIB_DATA_REG              (*((volatile uint32 *)0x400FC030))
+
 /*****************************************************************************
 Flash Registers
 *****************************************************************************/
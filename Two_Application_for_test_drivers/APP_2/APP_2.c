@@ -1,5 +1,7 @@
 #include "SysTick/SysTick.h"
 #include "NVIC/NVIC.h"
+#include "Fault/Fault.h"
+#include "Deadline/Deadline.h"
 #include "tm4c123gh6pm_registers.h"
 #include <assert.h>
 
@@ -11,6 +13,9 @@
 #define PENDSV_EXCEPTION_PRIORITY           6
 #define SYSTICK_EXCEPTION_PRIORITY          7
 
+#define LED_PERIOD_MS                       1000
+#define LEDS_NUMBER                         3
+
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
 void Leds_Init(void)
 {
@@ -70,10 +75,46 @@ void Test_Exceptions_Settings(void)
     /* Setup priority for SysTick Exception */
     NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,EXCEPTION_PRIORITY_LEVEL_7);
     assert(((NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) >> SYSTICK_PRIORITY_BITS_POS) == SYSTICK_EXCEPTION_PRIORITY);
+
+    /* Each priority is a separate byte store: no setting above may have changed a neighbouring field */
+    assert(((NVIC_SYSTEM_PRI1_REG & MEM_FAULT_PRIORITY_MASK) >> MEM_FAULT_PRIORITY_BITS_POS) == MEM_FAULT_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI1_REG & BUS_FAULT_PRIORITY_MASK) >> BUS_FAULT_PRIORITY_BITS_POS) == BUS_FAULT_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI1_REG & USAGE_FAULT_PRIORITY_MASK) >> USAGE_FAULT_PRIORITY_BITS_POS) == USAGE_FAULT_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI2_REG & SVC_PRIORITY_MASK) >> SVC_PRIORITY_BITS_POS) == SVC_EXCEPTION_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI3_REG & DEBUG_MONITOR_PRIORITY_MASK) >> DEBUG_MONITOR_PRIORITY_BITS_POS) == DEBUG_MONITOR_EXCEPTION_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI3_REG & PENDSV_PRIORITY_MASK) >> PENDSV_PRIORITY_BITS_POS) == PENDSV_EXCEPTION_PRIORITY);
+
+    /* Reserved bits of the priority registers stay untouched */
+    assert((NVIC_SYSTEM_PRI1_REG & 0xFF000000) == 0);
+    assert((NVIC_SYSTEM_PRI2_REG & 0x00FFFFFF) == 0);
+    assert((NVIC_SYSTEM_PRI3_REG & 0x0000FF00) == 0);
+
+    /* Reading back goes through the same byte fields */
+    assert(NVIC_GetPriorityException(EXCEPTION_MEM_FAULT_TYPE) == MEM_FAULT_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_BUS_FAULT_TYPE) == BUS_FAULT_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_USAGE_FAULT_TYPE) == USAGE_FAULT_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_SVC_TYPE) == SVC_EXCEPTION_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_DEBUG_MONITOR_TYPE) == DEBUG_MONITOR_EXCEPTION_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_PEND_SV_TYPE) == PENDSV_EXCEPTION_PRIORITY);
+    assert(NVIC_GetPriorityException(EXCEPTION_SYSTICK_TYPE) == SYSTICK_EXCEPTION_PRIORITY);
+
+    /* Raising SysTick to level 0 only changes its own field in PRI3 */
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,EXCEPTION_PRIORITY_LEVEL_0);
+    assert(((NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) >> SYSTICK_PRIORITY_BITS_POS) == 0);
+    assert(((NVIC_SYSTEM_PRI3_REG & DEBUG_MONITOR_PRIORITY_MASK) >> DEBUG_MONITOR_PRIORITY_BITS_POS) == DEBUG_MONITOR_EXCEPTION_PRIORITY);
+    assert(((NVIC_SYSTEM_PRI3_REG & PENDSV_PRIORITY_MASK) >> PENDSV_PRIORITY_BITS_POS) == PENDSV_EXCEPTION_PRIORITY);
+
+    /* Put SysTick back to the lowest level before the application starts */
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE,EXCEPTION_PRIORITY_LEVEL_7);
+    assert(((NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) >> SYSTICK_PRIORITY_BITS_POS) == SYSTICK_EXCEPTION_PRIORITY);
 }
 
 int main(void)
 {
+    const uint8 leds[LEDS_NUMBER] = {0x02, 0x04, 0x08};  /* Red, Blue and Green LEDs */
+    uint8 ledIndex = 0;
+    Deadline_Type ledDeadline;
+
     /* Enable clock for PORTF and wait for clock to start */
     SYSCTL_RCGCGPIO_REG |= 0x20;
     while(!(SYSCTL_PRGPIO_REG & 0x20));
@@ -88,13 +129,24 @@ int main(void)
     /* Test all System and Fault Exceptions settings */
     Test_Exceptions_Settings();
 
+    /* Take over the crash record of the previous run and enable the fault exceptions again */
+    Fault_Init();
+
+    /* Run SysTick as free-running timebase, the deadlines only read it */
+    SysTick_Init(LED_PERIOD_MS);
+
+    GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | leds[ledIndex]; /* Turn on the Red LED and disable the others */
+    ledDeadline = Deadline_Start(LED_PERIOD_MS);
+
     while(1)
     {
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        if(Deadline_Expired(ledDeadline))
+        {
+            ledDeadline = Deadline_Advance(ledDeadline, LED_PERIOD_MS); /* Next LED 1 second after this one, without drift */
+            ledIndex = (ledIndex + 1) % LEDS_NUMBER;
+            GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | leds[ledIndex]; /* Turn on the next LED and disable the others */
+        }
+
+        /* The core is free for other polled work between the LED changes */
     }
 }
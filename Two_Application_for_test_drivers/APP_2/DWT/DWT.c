@@ -0,0 +1,140 @@
+ /******************************************************************************
+ *
+ * Module: DWT
+ *
+ * File Name: DWT.c
+ *
+ * Description: Source file for the Cortex-M4 DWT cycle counter timestamps
+ *              and cycle exact delays
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "DWT.h"
+#include "SysTick/SysTick.h"
+#include "tm4c123gh6pm_registers.h"
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Busy wait a 64-bit number of cycles in chunks the
+ * 32-bit counter difference can measure.
+ * ********************************************************************/
+static void DWT_DelayLongCycles(uint64 a_Cycles)
+{
+    while(a_Cycles > DWT_MAX_DELAY_CYCLES)
+    {
+        DWT_DelayCycles(DWT_MAX_DELAY_CYCLES);
+        a_Cycles -= DWT_MAX_DELAY_CYCLES;
+    }
+
+    DWT_DelayCycles((uint32) a_Cycles);
+}
+
+/*******************************************************************************
+ *                          Functions Definitions                              *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: DWT_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the core has no cycle counter
+ * Description: Function to power the DWT unit and start the free running
+ * 32-bit cycle counter. The counter value is kept, so it is safe to call
+ * again while other code uses it (e.g. a debugger).
+ * ********************************************************************/
+Std_ReturnType DWT_Init(void)
+{
+    DEBUG_DEMCR_REG |= DEBUG_DEMCR_TRCENA_MASK;             // Power the DWT unit, its registers read as 0 before.
+
+    if(DWT_CTRL_REG & DWT_CTRL_NOCYCCNT_MASK)
+    {
+        return E_NOT_OK;
+    }
+
+    DWT_CTRL_REG |= DWT_CTRL_CYCCNTENA_MASK;                // Start counting core clock cycles.
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: DWT_GetCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Core clock cycles counter
+ * Description: Function to read a 32-bit cycle timestamp. The difference
+ * of two timestamps (end - start) is correct across one counter wrap.
+ * ********************************************************************/
+uint32 DWT_GetCycles(void)
+{
+    return DWT_CYCCNT_REG;
+}
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Cycles - Core clock cycles to wait (up to DWT_MAX_DELAY_CYCLES)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a number of core clock cycles,
+ * independent of the compiler and its optimization level.
+ * ********************************************************************/
+void DWT_DelayCycles(uint32 a_Cycles)
+{
+    uint32 start = DWT_CYCCNT_REG;
+
+    while( (DWT_CYCCNT_REG - start) < a_Cycles );           // Unsigned difference, correct across the counter wrap.
+}
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayUs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMicroSeconds - Time to wait in microseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a time in microseconds at the
+ * current core clock (SysTick_GetCoreClock).
+ * ********************************************************************/
+void DWT_DelayUs(uint32 a_TimeInMicroSeconds)
+{
+    DWT_DelayLongCycles( ((uint64) a_TimeInMicroSeconds * SysTick_GetCoreClock()) / 1000000UL );
+}
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayMs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time to wait in milliseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a time in milliseconds at the
+ * current core clock (SysTick_GetCoreClock).
+ * ********************************************************************/
+void DWT_DelayMs(uint32 a_TimeInMilliSeconds)
+{
+    DWT_DelayLongCycles( ((uint64) a_TimeInMilliSeconds * SysTick_GetCoreClock()) / 1000UL );
+}
@@ -0,0 +1,109 @@
+ /******************************************************************************
+ *
+ * Module: DWT
+ *
+ * File Name: DWT.h
+ *
+ * Description: Header file for the Cortex-M4 DWT cycle counter timestamps
+ *              and cycle exact delays
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef DWT_H_
+#define DWT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                             PreProcessor Macros                             *
+ *******************************************************************************/
+
+#define DEBUG_DEMCR_TRCENA_MASK          0x01000000         // Trace enable bit in DEMCR register, powers the DWT unit.
+#define DWT_CTRL_CYCCNTENA_MASK          0x00000001         // Cycle counter enable bit in DWT CTRL register.
+#define DWT_CTRL_NOCYCCNT_MASK           0x02000000         // Set in DWT CTRL register if the cycle counter is not implemented.
+
+#define DWT_MAX_DELAY_CYCLES             0x80000000UL       // Longest single wait, longer delays are split in chunks.
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: DWT_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK, E_NOT_OK if the core has no cycle counter
+ * Description: Function to power the DWT unit and start the free running
+ * 32-bit cycle counter. The counter value is kept, so it is safe to call
+ * again while other code uses it (e.g. a debugger).
+ * ********************************************************************/
+Std_ReturnType DWT_Init(void);
+
+
+/*********************************************************************
+ * Service Name: DWT_GetCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Core clock cycles counter
+ * Description: Function to read a 32-bit cycle timestamp. The difference
+ * of two timestamps (end - start) is correct across one counter wrap.
+ * ********************************************************************/
+uint32 DWT_GetCycles(void);
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayCycles
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Cycles - Core clock cycles to wait (up to DWT_MAX_DELAY_CYCLES)
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a number of core clock cycles,
+ * independent of the compiler and its optimization level.
+ * ********************************************************************/
+void DWT_DelayCycles(uint32 a_Cycles);
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayUs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMicroSeconds - Time to wait in microseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a time in microseconds at the
+ * current core clock (SysTick_GetCoreClock).
+ * ********************************************************************/
+void DWT_DelayUs(uint32 a_TimeInMicroSeconds);
+
+
+/*********************************************************************
+ * Service Name: DWT_DelayMs
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time to wait in milliseconds
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to busy wait a time in milliseconds at the
+ * current core clock (SysTick_GetCoreClock).
+ * ********************************************************************/
+void DWT_DelayMs(uint32 a_TimeInMilliSeconds);
+
+
+#endif /* DWT_H_ */
@@ -0,0 +1,95 @@
+ /******************************************************************************
+ *
+ * Module: Deadline
+ *
+ * File Name: Deadline.h
+ *
+ * Description: Header file for the non-blocking deadlines based on the
+ *              free-running SysTick monotonic time
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef DEADLINE_H_
+#define DEADLINE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Deadline handle: the SysTick_GetMicros time at which the deadline expires. Microseconds stay
+ * valid across core clock changes, SysTick_UpdateCoreClock and SysTick_Calibrate keep that time
+ * continuous while they rescale the clock tick based time. */
+typedef uint64 Deadline_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+
+/*********************************************************************
+ * Service Name: Deadline_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_TimeInMilliSeconds - Time until the deadline expires
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Deadline_Type - Handle of the new deadline
+ * Description: Function to start a deadline relative to now. It only
+ * reads the SysTick monotonic time, so the SysTick timer must already
+ * run (SysTick_Init / SysTick_InitPeriod with any period) and its
+ * configuration is left untouched.
+ * ********************************************************************/
+Deadline_Type Deadline_Start(uint32 a_TimeInMilliSeconds);
+
+
+/*********************************************************************
+ * Service Name: Deadline_Advance
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of an expired deadline
+ *                  a_TimeInMilliSeconds - Time from that deadline to the next one
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Deadline_Type - Handle of the next deadline
+ * Description: Function to chain periodic deadlines from the previous
+ * expiry instead of from now, so a polling loop does not drift by the
+ * time it takes to notice the expiry.
+ * ********************************************************************/
+Deadline_Type Deadline_Advance(Deadline_Type a_Deadline, uint32 a_TimeInMilliSeconds);
+
+
+/*********************************************************************
+ * Service Name: Deadline_Expired
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of the deadline
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE once the deadline has passed
+ * Description: Function to check a deadline without blocking.
+ * ********************************************************************/
+boolean Deadline_Expired(Deadline_Type a_Deadline);
+
+
+/*********************************************************************
+ * Service Name: Deadline_Remaining
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): a_Deadline - Handle of the deadline
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Milliseconds until the deadline (rounded up), 0 once it expired
+ * Description: Function to get the time left until a deadline.
+ * ********************************************************************/
+uint32 Deadline_Remaining(Deadline_Type a_Deadline);
+
+
+#endif /* DEADLINE_H_ */
@@ -16,6 +16,11 @@
 
 #include "NVIC.h"
 #include "tm4c123gh6pm_registers.h"
+#include "Critical/Critical.h"
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+#include "DWT/DWT.h"
+#endif
 
 
 
@@ -29,8 +34,156 @@ volatile uint32 * NVIC_PRI_n_REGS[35] = { &NVIC_PRI0_REG, &NVIC_PRI1_REG, &NVIC_
                                  &NVIC_PRI28_REG, &NVIC_PRI29_REG, &NVIC_PRI30_REG, &NVIC_PRI31_REG,
                                  &NVIC_PRI32_REG, &NVIC_PRI33_REG, &NVIC_PRI34_REG };
 
+/* Compile time checks of NVIC_Cfg.h: an IRQ number or priority out of range gives
+ * a negative array size, an IRQ listed twice gives a redefined enumerator */
+#define NVIC_CFG_CAT(A, B)                          NVIC_CFG_CAT_(A, B)
+#define NVIC_CFG_CAT_(A, B)                         A##B
+#define NVIC_CFG_CHECK(IRQ, PRIORITY, ENABLED)                                                              \
+    typedef char NVIC_CFG_CAT(NVIC_Cfg_RangeCheck_IRQ, IRQ)                                                \
+        [ ( ((IRQ) < NVIC_IRQS_NUMBER) && ((PRIORITY) <= NVIC_MAX_PRIORITY) ) ? 1 : -1 ];                   \
+    enum { NVIC_CFG_CAT(NVIC_Cfg_DuplicateCheck_IRQ, IRQ) };
+
+NVIC_CONFIG_TABLE(NVIC_CFG_CHECK)
+
+#define NVIC_CFG_END_IRQ                            0xFF    // Out of range IRQ number that terminates the table.
+#define NVIC_CFG_ENTRY(IRQ, PRIORITY, ENABLED)      { (IRQ), (PRIORITY), (ENABLED) },
+
+static const NVIC_ConfigType g_nvicConfig[] =
+{
+    NVIC_CONFIG_TABLE(NVIC_CFG_ENTRY)
+    { NVIC_CFG_END_IRQ, 0, FALSE }
+};
+
+/* System exception number of each NVIC_ExceptionType, its priority byte is NVIC_SYSTEM_PRI_BYTE(number).
+ * 0 for Reset, NMI and Hard Fault, which have fixed priorities, and for the IRQs as a whole */
+static const uint8 g_systemExceptionNum[EXCEPTION_INTERRUPT_TYPE + 1] =
+{
+    0,      // EXCEPTION_RESET_TYPE
+    0,      // EXCEPTION_NMI_TYPE
+    0,      // EXCEPTION_HARD_FAULT_TYPE
+    4,      // EXCEPTION_MEM_FAULT_TYPE
+    5,      // EXCEPTION_BUS_FAULT_TYPE
+    6,      // EXCEPTION_USAGE_FAULT_TYPE
+    11,     // EXCEPTION_SVC_TYPE
+    12,     // EXCEPTION_DEBUG_MONITOR_TYPE
+    14,     // EXCEPTION_PEND_SV_TYPE
+    15,     // EXCEPTION_SYSTICK_TYPE
+    0       // EXCEPTION_INTERRUPT_TYPE
+};
+
+extern void (* const g_pfnVectors[])(void);             // Flash vector table of tm4c123gh6pm_startup_ccs.c.
+
+#if (NVIC_SRAM_VECTOR_TABLE == TRUE)
+/* The linker command file places .vtable at the start of SRAM */
+#pragma DATA_ALIGN(g_ramVectors, NVIC_VECTOR_TABLE_ALIGN)
+#pragma DATA_SECTION(g_ramVectors, ".vtable")
+static NVIC_VectorHandlerType g_ramVectors[NVIC_VECTORS_NUMBER];
+#endif
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+#if (NVIC_SRAM_VECTOR_TABLE != TRUE)
+#error "NVIC_IRQ_PROFILING needs NVIC_SRAM_VECTOR_TABLE"
+#endif
+static NVIC_VectorHandlerType g_profiledHandlers[NVIC_VECTORS_NUMBER];  // Real handlers of the vectors that run through the shim.
+static NVIC_IrqStatsType g_irqStats[NVIC_VECTORS_NUMBER];
+static volatile uint8  g_nesting = 0;                   // Exceptions currently inside the shim.
+static volatile uint32 g_nestedCycles = 0;              // Cycles of the exceptions nested in the running one.
+#endif
+
+
+
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/*********************************************************************
+ * Description: Check a (preempt, sub) pair against the ranges of the
+ * current priority grouping and pack it into a priority value.
+ * ********************************************************************/
+static Std_ReturnType NVIC_GroupedToPriority(uint8 Preempt, uint8 Sub, uint8 *Priority)
+{
+    NVIC_PriorityGroupType group = NVIC_GetPriorityGrouping();
+    uint8 subBits = (uint8)group - NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB;
+
+    if( (Preempt >= (1 << (NVIC_PRIORITY_BITS - subBits))) || (Sub >= (1 << subBits)) )
+    {
+        return E_NOT_OK;
+    }
 
+    *Priority = NVIC_EncodePriority(group, Preempt, Sub);
 
+    return E_OK;
+}
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+/*********************************************************************
+ * Description: Common entry of every profiled vector. It finds its
+ * vector from VECTACTIVE, runs the real handler and charges it the
+ * elapsed cycles minus the cycles of the exceptions nested in it. The
+ * same vector can not preempt itself, so its stats have one writer.
+ * The nesting bookkeeping runs masked: an exception between reading
+ * and writing back g_nestedCycles would have its cycles lost.
+ * ********************************************************************/
+static void NVIC_ProfileShim(void)
+{
+    uint8  vector      = NVIC_SYSTEM_INTCTRL & NVIC_INTCTRL_VECACT_MASK;
+    NVIC_IrqStatsType *stats = &g_irqStats[vector];
+    Critical_StateType state;
+    uint32 outerNested;
+    uint32 start;
+    uint32 elapsed;
+    uint32 cycles;
+
+    state = Critical_Enter();
+    outerNested    = g_nestedCycles;                    // Save the preempted handler's count and start a fresh one.
+    g_nestedCycles = 0;
+    g_nesting++;
+    if(g_nesting > stats->MaxNesting)
+    {
+        stats->MaxNesting = g_nesting;
+    }
+    start = DWT_GetCycles();
+    Critical_Exit(state);
+
+    g_profiledHandlers[vector]();
+
+    state = Critical_Enter();
+    elapsed = DWT_GetCycles() - start;
+    cycles  = elapsed - g_nestedCycles;                 // Exclude the exceptions nested in this handler.
+    g_nestedCycles = outerNested + elapsed;             // and charge the whole run away from the preempted one.
+    g_nesting--;
+    Critical_Exit(state);
+
+    stats->Count++;
+    stats->TotalCycles += cycles;
+    if(cycles > stats->MaxCycles)
+    {
+        stats->MaxCycles = cycles;
+    }
+}
+
+
+/*********************************************************************
+ * Description: Route a vector of the SRAM table through the shim. The
+ * stack pointer, reset, NMI, fault and empty vectors are not wrapped,
+ * neither are SVCall and PendSV: fault capture and context switch code
+ * need their exception entry state (EXC_RETURN in LR), which a C
+ * function call in between loses.
+ * ********************************************************************/
+static void NVIC_WrapVector(uint8 Vector_Num, NVIC_VectorHandlerType Handler)
+{
+    if( (Vector_Num <= NVIC_SVC_VECTOR) || (Handler == NULL_PTR) || (Vector_Num == NVIC_PEND_SV_VECTOR) )
+    {
+        g_ramVectors[Vector_Num] = Handler;
+    }
+    else
+    {
+        g_profiledHandlers[Vector_Num] = Handler;
+        g_ramVectors[Vector_Num]       = NVIC_ProfileShim;
+    }
+}
+#endif
 
 /*******************************************************************************
  *                          Functions Definitions                              *
@@ -49,35 +202,10 @@ volatile uint32 * NVIC_PRI_n_REGS[35] = { &NVIC_PRI0_REG, &NVIC_PRI1_REG, &NVIC_
 ****************************************************************************/
 void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
 {
-    uint8 EN_n_REG = IRQ_Num / 32;             // Determine which EN REG having IRQ number.
-    uint8 bit_pos  = IRQ_Num % 32;             // Determine which bit responsible to enable the interrupt for the IRQ number given.
-
-    switch (EN_n_REG)
+    if(IRQ_Num < NVIC_IRQS_NUMBER)
     {
-    case EN_0_REG :
-
-        NVIC_EN0_REG  |= ( 1 << bit_pos );     // Enable interrupt for corresponding IRQ number.
-        break;
-
-    case EN_1_REG :
-
-        NVIC_EN1_REG  |= ( 1 << bit_pos );     // Enable interrupt for corresponding IRQ number.
-        break;
-
-    case EN_2_REG :
-
-        NVIC_EN2_REG  |= ( 1 << bit_pos );     // Enable interrupt for corresponding IRQ number.
-        break;
-
-    case EN_3_REG :
-
-        NVIC_EN3_REG  |= ( 1 << bit_pos );     // Enable interrupt for corresponding IRQ number.
-        break;
-
-    case EN_4_REG :
-
-        NVIC_EN4_REG  |= ( 1 << bit_pos );     // Enable interrupt for corresponding IRQ number.
-        break;
+        /* EN registers are write-one-to-set, a single store enables the IRQ without touching the others */
+        (&NVIC_EN0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] = ( 1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK) );
     }
 }
 
@@ -94,35 +222,155 @@ void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num)
  * **************************************************************************/
 void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num)
 {
-    uint8 DIS_n_REG = IRQ_Num / 32;             // Determine which DIS REG having IRQ number.
-    uint8 bit_pos   = IRQ_Num % 32;             // Determine which bit responsible to disable the interrupt for the IRQ number given.
+    if(IRQ_Num < NVIC_IRQS_NUMBER)
+    {
+        /* DIS registers are write-one-to-clear and read back the enabled IRQs, so never read-modify-write them */
+        (&NVIC_DIS0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] = ( 1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK) );
+    }
+}
+
 
-    switch (DIS_n_REG)
+/***************************************************************************
+ * Service Name: NVIC_EnableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Reg_Num - EN register index (IRQ number / 32)
+ *                  IRQ_Mask - One bit per IRQ (IRQ number % 32) to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable up to 32 Interrupt requests with a
+ * single store, IRQs with a 0 bit are not affected.
+ * **************************************************************************/
+void NVIC_EnableIRQMask(uint8 Reg_Num, uint32 IRQ_Mask)
+{
+    if(Reg_Num < NVIC_IRQ_REGS_NUMBER)
     {
-    case DIS_0_REG :
+        (&NVIC_EN0_REG)[Reg_Num] = IRQ_Mask;
+    }
+}
 
-        NVIC_DIS0_REG  |= ( 1 << bit_pos );     // Disable interrupt for corresponding IRQ number.
-        break;
 
-    case DIS_1_REG :
+/***************************************************************************
+ * Service Name: NVIC_DisableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Reg_Num - DIS register index (IRQ number / 32)
+ *                  IRQ_Mask - One bit per IRQ (IRQ number % 32) to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable up to 32 Interrupt requests with a
+ * single store, IRQs with a 0 bit are not affected.
+ * **************************************************************************/
+void NVIC_DisableIRQMask(uint8 Reg_Num, uint32 IRQ_Mask)
+{
+    if(Reg_Num < NVIC_IRQ_REGS_NUMBER)
+    {
+        (&NVIC_DIS0_REG)[Reg_Num] = IRQ_Mask;
+    }
+}
 
-        NVIC_DIS1_REG  |= ( 1 << bit_pos );     // Disable interrupt for corresponding IRQ number.
-        break;
 
-    case DIS_2_REG :
+/*********************************************************************
+ * Service Name: NVIC_SetPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the pending state of specific IRQ, it is taken
+ * as soon as it is enabled and its priority allows it.
+ * **********************************************************************/
+void NVIC_SetPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    if(IRQ_Num < NVIC_IRQS_NUMBER)
+    {
+        /* PEND registers are write-one-to-set */
+        (&NVIC_PEND0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] = ( 1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK) );
+    }
+}
 
-        NVIC_DIS2_REG  |= ( 1 << bit_pos );     // Disable interrupt for corresponding IRQ number.
-        break;
 
-    case DIS_3_REG :
+/*********************************************************************
+ * Service Name: NVIC_ClearPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the pending state of specific IRQ.
+ * **********************************************************************/
+void NVIC_ClearPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    if(IRQ_Num < NVIC_IRQS_NUMBER)
+    {
+        /* UNPEND registers are write-one-to-clear */
+        (&NVIC_UNPEND0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] = ( 1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK) );
+    }
+}
 
-        NVIC_DIS3_REG  |= ( 1 << bit_pos );     // Disable interrupt for corresponding IRQ number.
-        break;
 
-    case DIS_4_REG :
+/*********************************************************************
+ * Service Name: NVIC_IsPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ is pending
+ * Description: Function to check the pending state of specific IRQ.
+ * **********************************************************************/
+boolean NVIC_IsPendingIRQ(NVIC_IRQType IRQ_Num)
+{
+    if( (IRQ_Num < NVIC_IRQS_NUMBER) && ( (&NVIC_PEND0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] & (1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK)) ) )
+    {
+        return TRUE;
+    }
+
+    return FALSE;
+}
 
-        NVIC_DIS4_REG  |= ( 1 << bit_pos );     // Disable interrupt for corresponding IRQ number.
-        break;
+
+/*********************************************************************
+ * Service Name: NVIC_IsActiveIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ handler runs or is preempted
+ * Description: Function to check the active state of specific IRQ.
+ * **********************************************************************/
+boolean NVIC_IsActiveIRQ(NVIC_IRQType IRQ_Num)
+{
+    if( (IRQ_Num < NVIC_IRQS_NUMBER) && ( (&NVIC_ACTIVE0_REG)[IRQ_Num >> NVIC_IRQ_REG_SHIFT] & (1UL << (IRQ_Num & NVIC_IRQ_BIT_MASK)) ) )
+    {
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_TriggerSoftwareIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pend specific IRQ through the software trigger
+ * register, a single store without register index or bit mask.
+ * **********************************************************************/
+void NVIC_TriggerSoftwareIRQ(NVIC_IRQType IRQ_Num)
+{
+    if(IRQ_Num < NVIC_IRQS_NUMBER)
+    {
+        NVIC_SW_TRIG_REG = IRQ_Num;
     }
 }
 
@@ -244,53 +492,394 @@ void NVIC_DisableException(NVIC_ExceptionType Exception_Num)
 
 /*********************************************************************
  * Service Name: NVIC_SetPriorityException
- * Sync/Async:
- * Reentrancy:
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different exceptions
  * Parameters (in): Exception_Num - Number of the Exception
  *                  Exception_Priority - Priority of the Exception
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to set the priority of specific Exception
+ * Description: Function to set the priority of specific Exception with a
+ * single byte store to its SHPR field, the neighbouring fields are not
+ * read or written. Exceptions with a fixed priority are ignored.
  * **********************************************************************/
 void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority)
 {
-    switch (Exception_Num)
+    if( (Exception_Num <= EXCEPTION_INTERRUPT_TYPE) && (g_systemExceptionNum[Exception_Num] != 0) )
     {
-    case EXCEPTION_MEM_FAULT_TYPE :
+        NVIC_SYSTEM_PRI_BYTE(g_systemExceptionNum[Exception_Num]) = (uint8)( (Exception_Priority & NVIC_MAX_PRIORITY) << NVIC_PRI_FIELD_BITS_POS );
+    }
+}
 
-        NVIC_SYSTEM_PRI1_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << MEM_FAULT_PRIORITY_BITS_POS ) )  | ( Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS );
-        break;
 
-    case EXCEPTION_BUS_FAULT_TYPE :
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the Exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_ExceptionPriorityType - Priority of the Exception, level 0 for exceptions with a fixed priority
+ * Description: Function to read the priority of specific Exception from
+ * its SHPR field.
+ * **********************************************************************/
+NVIC_ExceptionPriorityType NVIC_GetPriorityException(NVIC_ExceptionType Exception_Num)
+{
+    if( (Exception_Num <= EXCEPTION_INTERRUPT_TYPE) && (g_systemExceptionNum[Exception_Num] != 0) )
+    {
+        return (NVIC_ExceptionPriorityType)( NVIC_SYSTEM_PRI_BYTE(g_systemExceptionNum[Exception_Num]) >> NVIC_PRI_FIELD_BITS_POS );
+    }
 
-        NVIC_SYSTEM_PRI1_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << BUS_FAULT_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS );
-        break;
+    return EXCEPTION_PRIORITY_LEVEL_0;
+}
 
-    case EXCEPTION_USAGE_FAULT_TYPE :
 
-        NVIC_SYSTEM_PRI1_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << USAGE_FAULT_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS );
-        break;
+/*********************************************************************
+ * Service Name: NVIC_ApplyConfig
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to apply the NVIC_Cfg.h table at startup, every
+ * PRI and EN register used by the table is written once as a whole word.
+ * IRQs sharing a PRI register with a configured IRQ get priority 0, the
+ * reset value, so call it before any other priority setting.
+ * **********************************************************************/
+void NVIC_ApplyConfig(void)
+{
+    uint32 priWords[NVIC_PRI_REGS_NUMBER] = {0};
+    uint32 enWords[NVIC_IRQ_REGS_NUMBER]  = {0};
+    uint64 priUsed = 0;                                 // One bit per PRI register written by the table.
+    uint8  index;
 
-    case EXCEPTION_SVC_TYPE :
+    for(index = 0; g_nvicConfig[index].IRQ_Num != NVIC_CFG_END_IRQ; index++)
+    {
+        const NVIC_ConfigType *entry = &g_nvicConfig[index];
 
-        NVIC_SYSTEM_PRI2_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << SVC_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << SVC_PRIORITY_BITS_POS );
-        break;
+        priWords[entry->IRQ_Num / 4] |= (uint32)entry->IRQ_Priority << ( ( entry->IRQ_Num % 4 ) * 8 + NVIC_PRI_FIELD_BITS_POS );
+        priUsed |= ( 1ULL << (entry->IRQ_Num / 4) );
 
-    case EXCEPTION_DEBUG_MONITOR_TYPE :
+        if(entry->Enabled)
+        {
+            enWords[entry->IRQ_Num >> NVIC_IRQ_REG_SHIFT] |= ( 1UL << (entry->IRQ_Num & NVIC_IRQ_BIT_MASK) );
+        }
+    }
 
-        NVIC_SYSTEM_PRI3_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << DEBUG_MONITOR_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS );
-        break;
+    /* Priorities first, so no IRQ can fire at its reset priority */
+    for(index = 0; index < NVIC_PRI_REGS_NUMBER; index++)
+    {
+        if(priUsed & (1ULL << index))
+        {
+            (&NVIC_PRI0_REG)[index] = priWords[index];
+        }
+    }
 
-    case EXCEPTION_PEND_SV_TYPE :
+    for(index = 0; index < NVIC_IRQ_REGS_NUMBER; index++)
+    {
+        if(enWords[index] != 0)
+        {
+            (&NVIC_EN0_REG)[index] = enWords[index];
+        }
+    }
+}
 
-        NVIC_SYSTEM_PRI3_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << PENDSV_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << PENDSV_PRIORITY_BITS_POS );
-        break;
 
-    case EXCEPTION_SYSTICK_TYPE :
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the APINT PRIGROUP field. Set it once
+ * at startup before the priorities, it changes the meaning of all of them.
+ * **********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Group)
+{
+    /* The other writable APINT bits request resets, so write them as 0 */
+    NVIC_SYSTEM_APINT = NVIC_APINT_VECTKEY | ( ((uint32)Group << NVIC_APINT_PRIGROUP_BITS_POS) & NVIC_APINT_PRIGROUP_MASK );
+}
+
 
-        NVIC_SYSTEM_PRI3_REG  = ( NVIC_SYSTEM_PRI1_REG & ~(0x7 << SYSTICK_PRIORITY_BITS_POS ) )  |  ( Exception_Priority << SYSTICK_PRIORITY_BITS_POS );
-        break;
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_PriorityGroupType - Current split of the priority bits
+ * Description: Function to read the APINT PRIGROUP field.
+ * **********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void)
+{
+    uint32 group = (NVIC_SYSTEM_APINT & NVIC_APINT_PRIGROUP_MASK) >> NVIC_APINT_PRIGROUP_BITS_POS;
+
+    /* PRIGROUP 0 .. 4 all put the binary point below the 3 implemented bits */
+    if(group < NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB)
+    {
+        group = NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB;
+    }
+
+    return (NVIC_PriorityGroupType)group;
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_EncodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint8 - 3 bits priority value (0 .. 7), bits above the group ranges are dropped
+ * Description: Function to pack a (preempt, sub) pair into a priority value.
+ * **********************************************************************/
+uint8 NVIC_EncodePriority(NVIC_PriorityGroupType Group, uint8 Preempt, uint8 Sub)
+{
+    uint8 subBits = (uint8)Group - NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB;
+
+    return (uint8)( ( (Preempt << subBits) | (Sub & ((1 << subBits) - 1)) ) & NVIC_MAX_PRIORITY );
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_DecodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ *                  Priority - 3 bits priority value (0 .. 7)
+ * Parameters (inout): None
+ * Parameters (out): Preempt - Preemption priority
+ *                   Sub - Sub-priority
+ * Return value: None
+ * Description: Function to unpack a priority value into a (preempt, sub) pair.
+ * **********************************************************************/
+void NVIC_DecodePriority(NVIC_PriorityGroupType Group, uint8 Priority, uint8 *Preempt, uint8 *Sub)
+{
+    uint8 subBits = (uint8)Group - NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB;
+
+    *Preempt = (Priority & NVIC_MAX_PRIORITY) >> subBits;
+    *Sub     = Priority & ((1 << subBits) - 1);
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the priority is set, E_NOT_OK if a value is out of the current group range
+ * Description: Function to set the priority of specific IRQ as a
+ * (preempt, sub) pair of the current priority grouping.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt, uint8 Sub)
+{
+    uint8 priority;
+
+    if( (IRQ_Num >= NVIC_IRQS_NUMBER) || (NVIC_GroupedToPriority(Preempt, Sub, &priority) != E_OK) )
+    {
+        return E_NOT_OK;
+    }
+
+    NVIC_SetPriorityIRQ(IRQ_Num, priority);
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Exception_Num - Number of the Exception
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the priority is set, E_NOT_OK if a value is out of the current group range
+ * Description: Function to set the priority of specific Exception as a
+ * (preempt, sub) pair of the current priority grouping.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt, uint8 Sub)
+{
+    uint8 priority;
+
+    if(NVIC_GroupedToPriority(Preempt, Sub, &priority) != E_OK)
+    {
+        return E_NOT_OK;
     }
+
+    NVIC_SetPriorityException(Exception_Num, (NVIC_ExceptionPriorityType)priority);
+
+    return E_OK;
 }
 
+
+/*********************************************************************
+ * Service Name: NVIC_RelocateVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if VTOR points to the SRAM table, E_NOT_OK if NVIC_SRAM_VECTOR_TABLE is FALSE
+ * Description: Function to copy the flash vector table to SRAM and point
+ * VTOR at the copy, call it once at startup before NVIC_SetVector.
+ * **********************************************************************/
+Std_ReturnType NVIC_RelocateVectorTable(void)
+{
+#if (NVIC_SRAM_VECTOR_TABLE == TRUE)
+    uint8 index;
+
+    if(NVIC_SYSTEM_VTABLE != (uint32)g_ramVectors)
+    {
+        for(index = 0; index < NVIC_VECTORS_NUMBER; index++)
+        {
+#if (NVIC_IRQ_PROFILING == TRUE)
+            NVIC_WrapVector(index, g_pfnVectors[index]);
+#else
+            g_ramVectors[index] = g_pfnVectors[index];
+#endif
+        }
+
+        __asm(" DSB ");                                 // The copy must be complete before the core fetches vectors from it.
+        NVIC_SYSTEM_VTABLE = (uint32)g_ramVectors;
+        __asm(" DSB ");
+    }
+
+    return E_OK;
+#else
+    return E_NOT_OK;
+#endif
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetVector
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different vectors
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ *                  Handler - Function to run on the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the handler is installed, E_NOT_OK if the table is not relocated or the vector is invalid
+ * Description: Function to install a handler directly in the SRAM vector
+ * table, so the exception enters it without an extra call-back level.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetVector(uint8 Vector_Num, NVIC_VectorHandlerType Handler)
+{
+#if (NVIC_SRAM_VECTOR_TABLE == TRUE)
+    /* Vector 0 is the initial stack pointer and vector 1 the reset handler, both only read at reset */
+    if( (NVIC_SYSTEM_VTABLE != (uint32)g_ramVectors) || (Vector_Num < 2) || (Vector_Num >= NVIC_VECTORS_NUMBER) || (Handler == NULL_PTR) )
+    {
+        return E_NOT_OK;
+    }
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+    NVIC_WrapVector(Vector_Num, Handler);
+#else
+    g_ramVectors[Vector_Num] = Handler;
+#endif
+    __asm(" DSB ");                                     // Visible to the next vector fetch.
+
+    return E_OK;
+#else
+    (void)Vector_Num;
+    (void)Handler;
+    return E_NOT_OK;
+#endif
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_GetVector
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_VectorHandlerType - Handler of the active vector table, NULL_PTR for an invalid vector
+ * Description: Function to read a handler from the active vector table.
+ * **********************************************************************/
+NVIC_VectorHandlerType NVIC_GetVector(uint8 Vector_Num)
+{
+    if(Vector_Num >= NVIC_VECTORS_NUMBER)
+    {
+        return NULL_PTR;
+    }
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+    if( (NVIC_SYSTEM_VTABLE == (uint32)g_ramVectors) && (g_ramVectors[Vector_Num] == NVIC_ProfileShim) )
+    {
+        return g_profiledHandlers[Vector_Num];
+    }
+#endif
+
+    return ( (const NVIC_VectorHandlerType *)NVIC_SYSTEM_VTABLE )[Vector_Num];
+}
+
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+/*********************************************************************
+ * Service Name: NVIC_GetIrqStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ * Parameters (inout): None
+ * Parameters (out): Stats - Consistent copy of the vector profile
+ * Return value: Std_ReturnType - E_OK if copied, E_NOT_OK for an invalid vector
+ * Description: Function to read the profile of one IRQ or exception.
+ * **********************************************************************/
+Std_ReturnType NVIC_GetIrqStats(uint8 Vector_Num, NVIC_IrqStatsType *Stats)
+{
+    Critical_StateType state;
+
+    if( (Vector_Num >= NVIC_VECTORS_NUMBER) || (Stats == NULL_PTR) )
+    {
+        return E_NOT_OK;
+    }
+
+    state = Critical_Enter();
+    *Stats = g_irqStats[Vector_Num];
+    Critical_Exit(state);
+
+    return E_OK;
+}
+
+
+/*********************************************************************
+ * Service Name: NVIC_ResetIrqStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the profiles of all vectors.
+ * **********************************************************************/
+void NVIC_ResetIrqStats(void)
+{
+    Critical_StateType state = Critical_Enter();
+    uint8  index;
+
+    for(index = 0; index < NVIC_VECTORS_NUMBER; index++)
+    {
+        g_irqStats[index].Count       = 0;
+        g_irqStats[index].TotalCycles = 0;
+        g_irqStats[index].MaxCycles   = 0;
+        g_irqStats[index].MaxNesting  = 0;
+    }
+
+    Critical_Exit(state);
+}
+#endif
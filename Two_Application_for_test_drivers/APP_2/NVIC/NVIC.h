@@ -18,28 +18,40 @@
  *******************************************************************************/
 
 #include "std_types.h"
+#include "NVIC_Cfg.h"
 
 /*******************************************************************************
  *                             PreProcessor Macros                             *
  *******************************************************************************/
 
+/* Unconditional PRIMASK/FAULTMASK changes for startup code, use Critical/Critical.h for critical sections */
 #define Enable_Exceptions()     __asm(" CPSIE I ")       // Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK.
 #define Disable_Exceptions()    __asm(" CPSID I ")       // Disable Exceptions ... This Macro disable IRQ interrupts, Programmable Systems Exceptions and Faults by setting the I-bit in the PRIMASK.
 #define Enable_Faults()         __asm(" CPSIE F ")       // Enable Faults ... This Macro enable Faults by clearing the F-bit in the FAULTMASK.
 #define Disable_Faults()        __asm(" CPSID F ")       // Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK.
 #define Trigger_SVC_Exception() __asm(" SVC #0 ")        // Trigger SVC Exception ... This Macro use the SVC instruction to make SW Interrupt.
 
-#define EN_0_REG                          0              // Used in switch function to indicate that we will write in NVIC_EN0_REG.
-#define EN_1_REG                          1              // Used in switch function to indicate that we will write in NVIC_EN1_REG.
-#define EN_2_REG                          2              // Used in switch function to indicate that we will write in NVIC_EN2_REG.
-#define EN_3_REG                          3              // Used in switch function to indicate that we will write in NVIC_EN3_REG.
-#define EN_4_REG                          4              // Used in switch function to indicate that we will write in NVIC_EN4_REG.
-
-#define DIS_0_REG                         0              // Used in switch function to indicate that we will write in  NVIC_DIS0_REG.
-#define DIS_1_REG                         1              // Used in switch function to indicate that we will write in  NVIC_DIS1_REG.
-#define DIS_2_REG                         2              // Used in switch function to indicate that we will write in  NVIC_DIS2_REG.
-#define DIS_3_REG                         3              // Used in switch function to indicate that we will write in  NVIC_DIS3_REG.
-#define DIS_4_REG                         4              // Used in switch function to indicate that we will write in  NVIC_DIS4_REG.
+#define NVIC_IRQ_REGS_NUMBER              5              // EN/DIS/PEND/UNPEND/ACTIVE registers, 32 IRQs each.
+#define NVIC_IRQ_REG_SHIFT                5              // IRQ number / 32 gives the register index.
+#define NVIC_IRQ_BIT_MASK                 0x1F           // IRQ number % 32 gives the bit in the register.
+#define NVIC_IRQS_NUMBER                  139            // IRQs implemented by the TM4C123GH6PM.
+#define NVIC_PRI_REGS_NUMBER              35             // PRI registers, 4 IRQs each.
+#define NVIC_PRI_FIELD_BITS_POS           5              // Priority field position inside each IRQ byte of a PRI register.
+#define NVIC_MAX_PRIORITY                 7              // 3 bits priority fields, 0 is the highest priority.
+#define NVIC_PRIORITY_BITS                3              // Implemented priority bits, the upper bits of each 8 bits field.
+
+#define NVIC_VECTORS_NUMBER               155            // Stack pointer, 15 system exceptions and the IRQs.
+#define NVIC_VECTOR_TABLE_ALIGN           1024           // VTOR needs the table size rounded up to a power of 2.
+#define NVIC_IRQ_VECTOR(IRQ_Num)          ((IRQ_Num) + 16) // Vector number of an IRQ.
+#define NVIC_INTCTRL_VECACT_MASK          0x000000FF     // Vector number of the running exception.
+#define NVIC_INTCTRL_PEND_SV_MASK         0x10000000     // Write 1 to pend the PendSV exception.
+#define NVIC_SVC_VECTOR                   11
+#define NVIC_PEND_SV_VECTOR               14
+#define NVIC_SYSTICK_VECTOR               15
+
+#define NVIC_APINT_VECTKEY                0x05FA0000     // Key required in the upper half word of every APINT write.
+#define NVIC_APINT_PRIGROUP_MASK          0x00000700
+#define NVIC_APINT_PRIGROUP_BITS_POS      8
 
 #define MEM_FAULT_ENABLE_MASK             0x00010000
 #define MEM_FAULT_EXCEPTION_BIT_POS       16
@@ -106,6 +118,42 @@ typedef enum
     EXCEPTION_PRIORITY_LEVEL_7
 }NVIC_ExceptionPriorityType;
 
+
+/* Split of the 3 priority bits between preemption priority and sub-priority (APINT PRIGROUP value).
+ * Only the preemption priority decides nesting, equal preemption priorities tail-chain in sub-priority order */
+typedef enum
+{
+    NVIC_PRIORITY_GROUP_8_PREEMPT_1_SUB = 4,    // Reset split, flat preemption levels 0 .. 7.
+    NVIC_PRIORITY_GROUP_4_PREEMPT_2_SUB,        // Preemption 0 .. 3, sub-priority 0 .. 1.
+    NVIC_PRIORITY_GROUP_2_PREEMPT_4_SUB,        // Preemption 0 .. 1, sub-priority 0 .. 3.
+    NVIC_PRIORITY_GROUP_1_PREEMPT_8_SUB         // No nesting, sub-priority 0 .. 7.
+}NVIC_PriorityGroupType;
+
+
+/* Exception or interrupt handler stored in the vector table */
+typedef void (*NVIC_VectorHandlerType)(void);
+
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+/* Profile of one vector, the cycles exclude the time spent in nested exceptions */
+typedef struct
+{
+    uint32 Count;                               // Handler invocations.
+    uint64 TotalCycles;                         // Sum of the handler costs.
+    uint32 MaxCycles;                           // Most expensive invocation.
+    uint8  MaxNesting;                          // Deepest exception nesting seen on entry, 1 if never nested.
+}NVIC_IrqStatsType;
+#endif
+
+
+/* One IRQ of the boot configuration table, see NVIC_Cfg.h */
+typedef struct
+{
+    NVIC_IRQType         IRQ_Num;
+    NVIC_IRQPriorityType IRQ_Priority;
+    boolean              Enabled;
+}NVIC_ConfigType;
+
 /*******************************************************************************
  *                            Functions Prototypes                             *
  *******************************************************************************/
@@ -137,6 +185,103 @@ void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num);
 void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num);
 
 
+/*********************************************************************
+ * Service Name: NVIC_EnableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Reg_Num - EN register index (IRQ number / 32)
+ *                  IRQ_Mask - One bit per IRQ (IRQ number % 32) to enable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to enable up to 32 Interrupt requests with a
+ * single store, IRQs with a 0 bit are not affected.
+ * **********************************************************************/
+void NVIC_EnableIRQMask(uint8 Reg_Num, uint32 IRQ_Mask);
+
+
+/*********************************************************************
+ * Service Name: NVIC_DisableIRQMask
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Reg_Num - DIS register index (IRQ number / 32)
+ *                  IRQ_Mask - One bit per IRQ (IRQ number % 32) to disable
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to disable up to 32 Interrupt requests with a
+ * single store, IRQs with a 0 bit are not affected.
+ * **********************************************************************/
+void NVIC_DisableIRQMask(uint8 Reg_Num, uint32 IRQ_Mask);
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to set the pending state of specific IRQ, it is taken
+ * as soon as it is enabled and its priority allows it.
+ * **********************************************************************/
+void NVIC_SetPendingIRQ(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: NVIC_ClearPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the pending state of specific IRQ.
+ * **********************************************************************/
+void NVIC_ClearPendingIRQ(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: NVIC_IsPendingIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ is pending
+ * Description: Function to check the pending state of specific IRQ.
+ * **********************************************************************/
+boolean NVIC_IsPendingIRQ(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: NVIC_IsActiveIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the IRQ handler runs or is preempted
+ * Description: Function to check the active state of specific IRQ.
+ * **********************************************************************/
+boolean NVIC_IsActiveIRQ(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: NVIC_TriggerSoftwareIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to pend specific IRQ through the software trigger
+ * register, a single store without register index or bit mask.
+ * **********************************************************************/
+void NVIC_TriggerSoftwareIRQ(NVIC_IRQType IRQ_Num);
+
+
 /*********************************************************************
  * Service Name: NVIC_SetPriorityIRQ
  * Sync/Async:
@@ -179,16 +324,209 @@ void NVIC_DisableException(NVIC_ExceptionType Exception_Num);
 
 /*********************************************************************
  * Service Name: NVIC_SetPriorityException
- * Sync/Async:
- * Reentrancy:
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different exceptions
  * Parameters (in): Exception_Num - Number of the Exception
  *                  Exception_Priority - Priority of the Exception
  * Parameters (inout): None
  * Parameters (out): None
  * Return value: None
- * Description: Function to set the priority of specific Exception
+ * Description: Function to set the priority of specific Exception with a
+ * single byte store to its SHPR field, the neighbouring fields are not
+ * read or written. Exceptions with a fixed priority are ignored.
  * **********************************************************************/
 void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionPriorityType Exception_Priority);
 
 
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Number of the Exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_ExceptionPriorityType - Priority of the Exception, level 0 for exceptions with a fixed priority
+ * Description: Function to read the priority of specific Exception from
+ * its SHPR field.
+ * **********************************************************************/
+NVIC_ExceptionPriorityType NVIC_GetPriorityException(NVIC_ExceptionType Exception_Num);
+
+
+
+/*********************************************************************
+ * Service Name: NVIC_ApplyConfig
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to apply the NVIC_Cfg.h table at startup, every
+ * PRI and EN register used by the table is written once as a whole word.
+ * **********************************************************************/
+void NVIC_ApplyConfig(void);
+
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to program the APINT PRIGROUP field. Set it once
+ * at startup before the priorities, it changes the meaning of all of them.
+ * **********************************************************************/
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroupType Group);
+
+
+/*********************************************************************
+ * Service Name: NVIC_GetPriorityGrouping
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_PriorityGroupType - Current split of the priority bits
+ * Description: Function to read the APINT PRIGROUP field.
+ * **********************************************************************/
+NVIC_PriorityGroupType NVIC_GetPriorityGrouping(void);
+
+
+/*********************************************************************
+ * Service Name: NVIC_EncodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint8 - 3 bits priority value (0 .. 7), bits above the group ranges are dropped
+ * Description: Function to pack a (preempt, sub) pair into a priority value.
+ * **********************************************************************/
+uint8 NVIC_EncodePriority(NVIC_PriorityGroupType Group, uint8 Preempt, uint8 Sub);
+
+
+/*********************************************************************
+ * Service Name: NVIC_DecodePriority
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Group - Split of the priority bits
+ *                  Priority - 3 bits priority value (0 .. 7)
+ * Parameters (inout): None
+ * Parameters (out): Preempt - Preemption priority
+ *                   Sub - Sub-priority
+ * Return value: None
+ * Description: Function to unpack a priority value into a (preempt, sub) pair.
+ * **********************************************************************/
+void NVIC_DecodePriority(NVIC_PriorityGroupType Group, uint8 Priority, uint8 *Preempt, uint8 *Sub);
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityIRQ
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the priority is set, E_NOT_OK if a value is out of the current group range
+ * Description: Function to set the priority of specific IRQ as a
+ * (preempt, sub) pair of the current priority grouping.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetGroupedPriorityIRQ(NVIC_IRQType IRQ_Num, uint8 Preempt, uint8 Sub);
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetGroupedPriorityException
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): Exception_Num - Number of the Exception
+ *                  Preempt - Preemption priority
+ *                  Sub - Sub-priority
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the priority is set, E_NOT_OK if a value is out of the current group range
+ * Description: Function to set the priority of specific Exception as a
+ * (preempt, sub) pair of the current priority grouping.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetGroupedPriorityException(NVIC_ExceptionType Exception_Num, uint8 Preempt, uint8 Sub);
+
+
+
+/*********************************************************************
+ * Service Name: NVIC_RelocateVectorTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if VTOR points to the SRAM table, E_NOT_OK if NVIC_SRAM_VECTOR_TABLE is FALSE
+ * Description: Function to copy the flash vector table to SRAM and point
+ * VTOR at the copy, call it once at startup before NVIC_SetVector.
+ * **********************************************************************/
+Std_ReturnType NVIC_RelocateVectorTable(void);
+
+
+/*********************************************************************
+ * Service Name: NVIC_SetVector
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant for different vectors
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ *                  Handler - Function to run on the exception
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: Std_ReturnType - E_OK if the handler is installed, E_NOT_OK if the table is not relocated or the vector is invalid
+ * Description: Function to install a handler directly in the SRAM vector
+ * table, so the exception enters it without an extra call-back level.
+ * **********************************************************************/
+Std_ReturnType NVIC_SetVector(uint8 Vector_Num, NVIC_VectorHandlerType Handler);
+
+
+/*********************************************************************
+ * Service Name: NVIC_GetVector
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: NVIC_VectorHandlerType - Handler of the active vector table, NULL_PTR for an invalid vector
+ * Description: Function to read a handler from the active vector table.
+ * **********************************************************************/
+NVIC_VectorHandlerType NVIC_GetVector(uint8 Vector_Num);
+
+
+
+#if (NVIC_IRQ_PROFILING == TRUE)
+/*********************************************************************
+ * Service Name: NVIC_GetIrqStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Vector_Num - Vector number, NVIC_IRQ_VECTOR(IRQ_Num) for an IRQ
+ * Parameters (inout): None
+ * Parameters (out): Stats - Consistent copy of the vector profile
+ * Return value: Std_ReturnType - E_OK if copied, E_NOT_OK for an invalid vector
+ * Description: Function to read the profile of one IRQ or exception.
+ * **********************************************************************/
+Std_ReturnType NVIC_GetIrqStats(uint8 Vector_Num, NVIC_IrqStatsType *Stats);
+
+
+/*********************************************************************
+ * Service Name: NVIC_ResetIrqStats
+ * Sync/Async: Synchronous
+ * Reentrancy: Non Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Function to clear the profiles of all vectors.
+ * **********************************************************************/
+void NVIC_ResetIrqStats(void);
+#endif
+
+
 #endif /* NVIC_H_ */
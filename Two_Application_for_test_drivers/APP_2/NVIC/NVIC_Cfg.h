@@ -0,0 +1,32 @@
+/******************************************************************************
+ *
+ * Module: NVIC
+ *
+ * File Name: NVIC_Cfg.h
+ *
+ * Description: Pre-Compile configuration header file for the TM4C123GH6PM NVIC driver
+ *
+ * Author: Bassam Ashraf
+ *
+ *******************************************************************************/
+
+#ifndef NVIC_CFG_H_
+#define NVIC_CFG_H_
+
+/* TRUE copies the vector table to SRAM in NVIC_RelocateVectorTable so handlers can be
+ * installed at runtime with NVIC_SetVector, costs 1 KB of SRAM in the .vtable section */
+#define NVIC_SRAM_VECTOR_TABLE                  FALSE
+
+/* TRUE wraps the vectors of the SRAM table with a shim that counts invocations and DWT cycles
+ * per vector (needs NVIC_SRAM_VECTOR_TABLE and DWT_Init), compiled out completely when FALSE */
+#define NVIC_IRQ_PROFILING                      FALSE
+
+/*
+ * IRQs configured by NVIC_ApplyConfig at startup, one line per IRQ:
+ *     ENTRY( IRQ number (0 .. 138), Priority (0 .. 7), Enabled (TRUE / FALSE) )
+ * Use plain numbers, ranges and duplicated IRQs are rejected when NVIC.c is compiled.
+ */
+#define NVIC_CONFIG_TABLE(ENTRY)                                        \
+    /*      IRQ   Priority   Enabled */                                 \
+
+#endif /* NVIC_CFG_H_ */